@@ -0,0 +1,31 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[2];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_INT, 128, 0, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(0), out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 1, nls_aot_exprs);
+}
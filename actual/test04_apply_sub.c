@@ -0,0 +1,43 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[7];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "sub"},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_LIST, 2, -1, NULL},
+	{NLS_TYPE_LIST, 1, 3, NULL},
+	{NLS_TYPE_APPLICATION, 0, 4, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(0), nls_func_sub)) {
+		int i0, i1;
+
+		i0 = 3;
+		i1 = 2;
+		return nls_aot_int(i0 - i1, out);
+	}
+	return nls_aot_apply(K(5), frame, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 6, nls_aot_exprs);
+}
@@ -0,0 +1,85 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[22];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_INT, 5, 0, NULL},
+	{NLS_TYPE_INT, 9, 0, NULL},
+	{NLS_TYPE_LIST, 3, -1, NULL},
+	{NLS_TYPE_LIST, 2, 4, NULL},
+	{NLS_TYPE_APPLICATION, 1, 5, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_INT, 7, 0, NULL},
+	{NLS_TYPE_VAR, -1, 0, "div"},
+	{NLS_TYPE_INT, 6, 0, NULL},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_LIST, 11, -1, NULL},
+	{NLS_TYPE_LIST, 10, 12, NULL},
+	{NLS_TYPE_APPLICATION, 9, 13, NULL},
+	{NLS_TYPE_LIST, 14, -1, NULL},
+	{NLS_TYPE_LIST, 8, 15, NULL},
+	{NLS_TYPE_APPLICATION, 7, 16, NULL},
+	{NLS_TYPE_LIST, 17, -1, NULL},
+	{NLS_TYPE_LIST, 6, 18, NULL},
+	{NLS_TYPE_APPLICATION, 0, 19, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(0), nls_func_add)) {
+		int i0, i1;
+
+		if (nls_aot_holds(K(1), nls_func_mul)) {
+			int i2, i3;
+
+			i2 = 5;
+			i3 = 9;
+			i0 = i2 * i3;
+		} else {
+			NLS_AOT_INT_OF(nls_aot_apply(K(6), frame, &v), v, i0);
+		}
+		if (nls_aot_holds(K(7), nls_func_mul)) {
+			int i4, i5;
+
+			i4 = 7;
+			if (nls_aot_holds(K(9), nls_func_div)) {
+				int i6, i7;
+
+				i6 = 6;
+				i7 = 2;
+				i5 = i6 / i7;
+			} else {
+				NLS_AOT_INT_OF(nls_aot_apply(K(14), frame, &v), v, i5);
+			}
+			i1 = i4 * i5;
+		} else {
+			NLS_AOT_INT_OF(nls_aot_apply(K(17), frame, &v), v, i1);
+		}
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(20), frame, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 21, nls_aot_exprs);
+}
@@ -0,0 +1,68 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[13];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_INT, 125, 0, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_INT, 1, 0, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_LIST, 5, -1, NULL},
+	{NLS_TYPE_LIST, 4, 6, NULL},
+	{NLS_TYPE_APPLICATION, 3, 7, NULL},
+	{NLS_TYPE_LIST, 8, -1, NULL},
+	{NLS_TYPE_LIST, 2, 9, NULL},
+	{NLS_TYPE_APPLICATION, 1, 10, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(0), out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(1), nls_func_add)) {
+		int i0, i1;
+
+		i0 = 1;
+		if (nls_aot_holds(K(3), nls_func_add)) {
+			int i2, i3;
+
+			i2 = 2;
+			i3 = 3;
+			i1 = i2 + i3;
+		} else {
+			NLS_AOT_INT_OF(nls_aot_apply(K(8), frame, &v), v, i1);
+		}
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(11), frame, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 12, nls_aot_exprs);
+}
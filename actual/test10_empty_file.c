@@ -0,0 +1,22 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[1];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{0, 0, 0, NULL},
+};
+
+
+static nls_aot_fp nls_aot_exprs[] = {
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 0, nls_aot_exprs);
+}
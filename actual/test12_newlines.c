@@ -0,0 +1,52 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[8];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_INT, 5123, 0, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_INT, 18, 0, NULL},
+	{NLS_TYPE_INT, 7, 0, NULL},
+	{NLS_TYPE_LIST, 3, -1, NULL},
+	{NLS_TYPE_LIST, 2, 4, NULL},
+	{NLS_TYPE_APPLICATION, 1, 5, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(0), out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(1), nls_func_add)) {
+		int i0, i1;
+
+		i0 = 18;
+		i1 = 7;
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(6), frame, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 7, nls_aot_exprs);
+}
@@ -0,0 +1,37 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[8];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_INT, 1, 0, NULL},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_LIST, 2, -1, NULL},
+	{NLS_TYPE_LIST, 2, 3, NULL},
+	{NLS_TYPE_LIST, 1, 4, NULL},
+	{NLS_TYPE_LIST, 0, 5, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(6), out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 7, nls_aot_exprs);
+}
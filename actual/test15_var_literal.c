@@ -0,0 +1,76 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[7];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "a"},
+	{NLS_TYPE_VAR, -1, 0, "a1"},
+	{NLS_TYPE_VAR, -1, 0, "b_"},
+	{NLS_TYPE_VAR, -1, 0, "_x"},
+	{NLS_TYPE_VAR, -1, 0, "_y_"},
+	{NLS_TYPE_VAR, -1, 0, "_y1_"},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t3(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t4(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t5(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(0), out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(1), out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(2), out);
+}
+
+static int
+nls_aot_t3(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(3), out);
+}
+
+static int
+nls_aot_t4(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(4), out);
+}
+
+static int
+nls_aot_t5(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(5), out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	nls_aot_t2,
+	nls_aot_t3,
+	nls_aot_t4,
+	nls_aot_t5,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 6, nls_aot_exprs);
+}
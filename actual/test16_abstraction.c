@@ -0,0 +1,39 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[10];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 0, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_INT, 1, 0, NULL},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_LIST, 4, -1, NULL},
+	{NLS_TYPE_LIST, 3, 5, NULL},
+	{NLS_TYPE_APPLICATION, 2, 6, NULL},
+	{NLS_TYPE_ABSTRACTION, 1, 7, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(8), out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 9, nls_aot_exprs);
+}
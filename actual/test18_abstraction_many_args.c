@@ -0,0 +1,48 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[19];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "y"},
+	{NLS_TYPE_VAR, -1, 0, "z"},
+	{NLS_TYPE_LIST, 2, -1, NULL},
+	{NLS_TYPE_LIST, 1, 3, NULL},
+	{NLS_TYPE_LIST, 0, 4, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, 1, 0, "y"},
+	{NLS_TYPE_LIST, 9, -1, NULL},
+	{NLS_TYPE_LIST, 8, 10, NULL},
+	{NLS_TYPE_APPLICATION, 7, 11, NULL},
+	{NLS_TYPE_VAR, 2, 0, "z"},
+	{NLS_TYPE_LIST, 13, -1, NULL},
+	{NLS_TYPE_LIST, 12, 14, NULL},
+	{NLS_TYPE_APPLICATION, 6, 15, NULL},
+	{NLS_TYPE_ABSTRACTION, 5, 16, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(17), out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 18, nls_aot_exprs);
+}
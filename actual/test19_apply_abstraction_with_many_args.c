@@ -0,0 +1,106 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[26];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "y"},
+	{NLS_TYPE_VAR, -1, 0, "z"},
+	{NLS_TYPE_LIST, 2, -1, NULL},
+	{NLS_TYPE_LIST, 1, 3, NULL},
+	{NLS_TYPE_LIST, 0, 4, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, 1, 0, "y"},
+	{NLS_TYPE_LIST, 9, -1, NULL},
+	{NLS_TYPE_LIST, 8, 10, NULL},
+	{NLS_TYPE_APPLICATION, 7, 11, NULL},
+	{NLS_TYPE_VAR, 2, 0, "z"},
+	{NLS_TYPE_LIST, 13, -1, NULL},
+	{NLS_TYPE_LIST, 12, 14, NULL},
+	{NLS_TYPE_APPLICATION, 6, 15, NULL},
+	{NLS_TYPE_ABSTRACTION, 5, 16, NULL},
+	{NLS_TYPE_INT, 5, 0, NULL},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_LIST, 20, -1, NULL},
+	{NLS_TYPE_LIST, 19, 21, NULL},
+	{NLS_TYPE_LIST, 18, 22, NULL},
+	{NLS_TYPE_APPLICATION, 17, 23, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t3(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t4(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(6), nls_func_add)) {
+		int i0, i1;
+
+		if (nls_aot_holds(K(7), nls_func_mul)) {
+			int i2, i3;
+
+			NLS_AOT_INT_OF(nls_aot_arg(K(8), frame, &v), v, i2);
+			NLS_AOT_INT_OF(nls_aot_arg(K(9), frame, &v), v, i3);
+			i0 = i2 * i3;
+		} else {
+			NLS_AOT_INT_OF(nls_aot_apply(K(12), frame, &v), v, i0);
+		}
+		NLS_AOT_INT_OF(nls_aot_arg(K(13), frame, &v), v, i1);
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(16), frame, out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(18), out);
+}
+
+static int
+nls_aot_t3(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(19), out);
+}
+
+static int
+nls_aot_t4(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(20), out);
+}
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[3];
+
+	nls_aot_thunk_init(&args[0], nls_aot_t2, K(18), frame);
+	nls_aot_thunk_init(&args[1], nls_aot_t3, K(19), frame);
+	nls_aot_thunk_init(&args[2], nls_aot_t4, K(20), frame);
+	return nls_aot_enter(nls_aot_t1, args, 3, frame, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 25, nls_aot_exprs);
+}
@@ -0,0 +1,95 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[23];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 0, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_LIST, 5, -1, NULL},
+	{NLS_TYPE_LIST, 4, 6, NULL},
+	{NLS_TYPE_APPLICATION, 3, 7, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_LIST, 11, -1, NULL},
+	{NLS_TYPE_LIST, 10, 12, NULL},
+	{NLS_TYPE_APPLICATION, 9, 13, NULL},
+	{NLS_TYPE_LIST, 14, -1, NULL},
+	{NLS_TYPE_LIST, 8, 15, NULL},
+	{NLS_TYPE_APPLICATION, 2, 16, NULL},
+	{NLS_TYPE_ABSTRACTION, 1, 17, NULL},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_LIST, 19, -1, NULL},
+	{NLS_TYPE_APPLICATION, 18, 20, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(2), nls_func_mul)) {
+		int i0, i1;
+
+		if (nls_aot_holds(K(3), nls_func_mul)) {
+			int i2, i3;
+
+			NLS_AOT_INT_OF(nls_aot_arg(K(4), frame, &v), v, i2);
+			NLS_AOT_INT_OF(nls_aot_arg(K(5), frame, &v), v, i3);
+			i0 = i2 * i3;
+		} else {
+			NLS_AOT_INT_OF(nls_aot_apply(K(8), frame, &v), v, i0);
+		}
+		if (nls_aot_holds(K(9), nls_func_mul)) {
+			int i4, i5;
+
+			NLS_AOT_INT_OF(nls_aot_arg(K(10), frame, &v), v, i4);
+			NLS_AOT_INT_OF(nls_aot_arg(K(11), frame, &v), v, i5);
+			i1 = i4 * i5;
+		} else {
+			NLS_AOT_INT_OF(nls_aot_apply(K(14), frame, &v), v, i1);
+		}
+		return nls_aot_int(i0 * i1, out);
+	}
+	return nls_aot_apply(K(17), frame, out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(19), out);
+}
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	nls_aot_thunk_init(&args[0], nls_aot_t2, K(19), frame);
+	return nls_aot_enter(nls_aot_t1, args, 1, frame, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 22, nls_aot_exprs);
+}
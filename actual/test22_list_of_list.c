@@ -0,0 +1,55 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[26];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_INT, 1, 0, NULL},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_LIST, 2, -1, NULL},
+	{NLS_TYPE_LIST, 1, 3, NULL},
+	{NLS_TYPE_LIST, 0, 4, NULL},
+	{NLS_TYPE_INT, 4, 0, NULL},
+	{NLS_TYPE_INT, 5, 0, NULL},
+	{NLS_TYPE_LIST, 7, -1, NULL},
+	{NLS_TYPE_LIST, 6, 8, NULL},
+	{NLS_TYPE_INT, 6, 0, NULL},
+	{NLS_TYPE_INT, 7, 0, NULL},
+	{NLS_TYPE_INT, 8, 0, NULL},
+	{NLS_TYPE_INT, 9, 0, NULL},
+	{NLS_TYPE_INT, 10, 0, NULL},
+	{NLS_TYPE_LIST, 14, -1, NULL},
+	{NLS_TYPE_LIST, 13, 15, NULL},
+	{NLS_TYPE_LIST, 12, 16, NULL},
+	{NLS_TYPE_INT, 11, 0, NULL},
+	{NLS_TYPE_LIST, 18, -1, NULL},
+	{NLS_TYPE_LIST, 17, 19, NULL},
+	{NLS_TYPE_LIST, 11, 20, NULL},
+	{NLS_TYPE_LIST, 10, 21, NULL},
+	{NLS_TYPE_LIST, 9, 22, NULL},
+	{NLS_TYPE_LIST, 5, 23, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(24), out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 25, nls_aot_exprs);
+}
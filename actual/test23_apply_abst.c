@@ -0,0 +1,45 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[16];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "abst"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 1, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mod"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_LIST, 5, -1, NULL},
+	{NLS_TYPE_LIST, 4, 6, NULL},
+	{NLS_TYPE_APPLICATION, 3, 7, NULL},
+	{NLS_TYPE_LIST, 8, -1, NULL},
+	{NLS_TYPE_LIST, 2, 9, NULL},
+	{NLS_TYPE_APPLICATION, 0, 10, NULL},
+	{NLS_TYPE_INT, 5, 0, NULL},
+	{NLS_TYPE_LIST, 12, -1, NULL},
+	{NLS_TYPE_APPLICATION, 11, 13, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(14), frame, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 15, nls_aot_exprs);
+}
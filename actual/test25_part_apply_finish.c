@@ -0,0 +1,37 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[8];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_INT, 5, 0, NULL},
+	{NLS_TYPE_LIST, 1, -1, NULL},
+	{NLS_TYPE_APPLICATION, 0, 2, NULL},
+	{NLS_TYPE_INT, 27, 0, NULL},
+	{NLS_TYPE_LIST, 4, -1, NULL},
+	{NLS_TYPE_APPLICATION, 3, 5, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(6), frame, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 7, nls_aot_exprs);
+}
@@ -0,0 +1,46 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[17];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "abst"},
+	{NLS_TYPE_VAR, -1, 0, "a"},
+	{NLS_TYPE_LIST, 1, -1, NULL},
+	{NLS_TYPE_LIST, 2, -1, NULL},
+	{NLS_TYPE_APPLICATION, 0, 3, NULL},
+	{NLS_TYPE_VAR, -1, 0, "sub"},
+	{NLS_TYPE_INT, 10, 0, NULL},
+	{NLS_TYPE_VAR, -1, 0, "a"},
+	{NLS_TYPE_LIST, 7, -1, NULL},
+	{NLS_TYPE_LIST, 6, 8, NULL},
+	{NLS_TYPE_APPLICATION, 5, 9, NULL},
+	{NLS_TYPE_LIST, 10, -1, NULL},
+	{NLS_TYPE_APPLICATION, 4, 11, NULL},
+	{NLS_TYPE_INT, 8, 0, NULL},
+	{NLS_TYPE_LIST, 13, -1, NULL},
+	{NLS_TYPE_APPLICATION, 12, 14, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(15), frame, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 16, nls_aot_exprs);
+}
@@ -0,0 +1,62 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[33];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "a"},
+	{NLS_TYPE_VAR, -1, 0, "b"},
+	{NLS_TYPE_VAR, -1, 0, "c"},
+	{NLS_TYPE_VAR, -1, 0, "d"},
+	{NLS_TYPE_VAR, -1, 0, "e"},
+	{NLS_TYPE_LIST, 4, -1, NULL},
+	{NLS_TYPE_LIST, 3, 5, NULL},
+	{NLS_TYPE_LIST, 2, 6, NULL},
+	{NLS_TYPE_LIST, 1, 7, NULL},
+	{NLS_TYPE_LIST, 0, 8, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mod"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "a"},
+	{NLS_TYPE_VAR, 1, 0, "b"},
+	{NLS_TYPE_LIST, 13, -1, NULL},
+	{NLS_TYPE_LIST, 12, 14, NULL},
+	{NLS_TYPE_APPLICATION, 11, 15, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 2, 0, "c"},
+	{NLS_TYPE_VAR, 3, 0, "d"},
+	{NLS_TYPE_LIST, 19, -1, NULL},
+	{NLS_TYPE_LIST, 18, 20, NULL},
+	{NLS_TYPE_APPLICATION, 17, 21, NULL},
+	{NLS_TYPE_LIST, 22, -1, NULL},
+	{NLS_TYPE_LIST, 16, 23, NULL},
+	{NLS_TYPE_APPLICATION, 10, 24, NULL},
+	{NLS_TYPE_ABSTRACTION, 9, 25, NULL},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_INT, 4, 0, NULL},
+	{NLS_TYPE_LIST, 28, -1, NULL},
+	{NLS_TYPE_LIST, 27, 29, NULL},
+	{NLS_TYPE_APPLICATION, 26, 30, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(31), frame, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 32, nls_aot_exprs);
+}
@@ -0,0 +1,72 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[43];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "a"},
+	{NLS_TYPE_VAR, -1, 0, "b"},
+	{NLS_TYPE_VAR, -1, 0, "c"},
+	{NLS_TYPE_VAR, -1, 0, "d"},
+	{NLS_TYPE_VAR, -1, 0, "e"},
+	{NLS_TYPE_LIST, 4, -1, NULL},
+	{NLS_TYPE_LIST, 3, 5, NULL},
+	{NLS_TYPE_LIST, 2, 6, NULL},
+	{NLS_TYPE_LIST, 1, 7, NULL},
+	{NLS_TYPE_LIST, 0, 8, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mod"},
+	{NLS_TYPE_VAR, -1, 0, "div"},
+	{NLS_TYPE_VAR, 0, 0, "a"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 1, 0, "b"},
+	{NLS_TYPE_VAR, 2, 0, "c"},
+	{NLS_TYPE_LIST, 15, -1, NULL},
+	{NLS_TYPE_LIST, 14, 16, NULL},
+	{NLS_TYPE_APPLICATION, 13, 17, NULL},
+	{NLS_TYPE_LIST, 18, -1, NULL},
+	{NLS_TYPE_LIST, 12, 19, NULL},
+	{NLS_TYPE_APPLICATION, 11, 20, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "a"},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 3, 0, "d"},
+	{NLS_TYPE_VAR, 4, 0, "e"},
+	{NLS_TYPE_LIST, 26, -1, NULL},
+	{NLS_TYPE_LIST, 25, 27, NULL},
+	{NLS_TYPE_APPLICATION, 24, 28, NULL},
+	{NLS_TYPE_LIST, 29, -1, NULL},
+	{NLS_TYPE_LIST, 23, 30, NULL},
+	{NLS_TYPE_APPLICATION, 22, 31, NULL},
+	{NLS_TYPE_LIST, 32, -1, NULL},
+	{NLS_TYPE_LIST, 21, 33, NULL},
+	{NLS_TYPE_APPLICATION, 10, 34, NULL},
+	{NLS_TYPE_ABSTRACTION, 9, 35, NULL},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_INT, 4, 0, NULL},
+	{NLS_TYPE_LIST, 38, -1, NULL},
+	{NLS_TYPE_LIST, 37, 39, NULL},
+	{NLS_TYPE_APPLICATION, 36, 40, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(41), frame, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 42, nls_aot_exprs);
+}
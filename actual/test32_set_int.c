@@ -0,0 +1,110 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[25];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "a"},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_LIST, 2, -1, NULL},
+	{NLS_TYPE_LIST, 1, 3, NULL},
+	{NLS_TYPE_APPLICATION, 0, 4, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, -1, 0, "a"},
+	{NLS_TYPE_VAR, -1, 0, "a"},
+	{NLS_TYPE_LIST, 8, -1, NULL},
+	{NLS_TYPE_LIST, 7, 9, NULL},
+	{NLS_TYPE_APPLICATION, 6, 10, NULL},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 12, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "div"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "a"},
+	{NLS_TYPE_LIST, 16, -1, NULL},
+	{NLS_TYPE_LIST, 15, 17, NULL},
+	{NLS_TYPE_APPLICATION, 14, 18, NULL},
+	{NLS_TYPE_ABSTRACTION, 13, 19, NULL},
+	{NLS_TYPE_INT, 16, 0, NULL},
+	{NLS_TYPE_LIST, 21, -1, NULL},
+	{NLS_TYPE_APPLICATION, 20, 22, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t3(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t4(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(0), nls_func_set)) {
+		return nls_aot_set(K(1), K(2), frame, out);
+	}
+	return nls_aot_apply(K(5), frame, out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(6), nls_func_mul)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_global(K(7), &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_global(K(8), &v), v, i1);
+		return nls_aot_int(i0 * i1, out);
+	}
+	return nls_aot_apply(K(11), frame, out);
+}
+
+static int
+nls_aot_t3(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(14), nls_func_div)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(15), frame, &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_global(K(16), &v), v, i1);
+		return nls_aot_int(i0 / i1, out);
+	}
+	return nls_aot_apply(K(19), frame, out);
+}
+
+static int
+nls_aot_t4(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(21), out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	nls_aot_thunk_init(&args[0], nls_aot_t4, K(21), frame);
+	return nls_aot_enter(nls_aot_t3, args, 1, frame, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	nls_aot_t2,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 24, nls_aot_exprs);
+}
@@ -0,0 +1,53 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[13];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "add2"},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_LIST, 2, -1, NULL},
+	{NLS_TYPE_LIST, 1, 3, NULL},
+	{NLS_TYPE_APPLICATION, 0, 4, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add2"},
+	{NLS_TYPE_INT, 22, 0, NULL},
+	{NLS_TYPE_INT, 135, 0, NULL},
+	{NLS_TYPE_LIST, 8, -1, NULL},
+	{NLS_TYPE_LIST, 7, 9, NULL},
+	{NLS_TYPE_APPLICATION, 6, 10, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(0), nls_func_set)) {
+		return nls_aot_set(K(1), K(2), frame, out);
+	}
+	return nls_aot_apply(K(5), frame, out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(11), frame, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 12, nls_aot_exprs);
+}
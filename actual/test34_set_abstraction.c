@@ -0,0 +1,89 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[19];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "square"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 2, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_LIST, 6, -1, NULL},
+	{NLS_TYPE_LIST, 5, 7, NULL},
+	{NLS_TYPE_APPLICATION, 4, 8, NULL},
+	{NLS_TYPE_ABSTRACTION, 3, 9, NULL},
+	{NLS_TYPE_LIST, 10, -1, NULL},
+	{NLS_TYPE_LIST, 1, 11, NULL},
+	{NLS_TYPE_APPLICATION, 0, 12, NULL},
+	{NLS_TYPE_VAR, -1, 0, "square"},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_LIST, 15, -1, NULL},
+	{NLS_TYPE_APPLICATION, 14, 16, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t3(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(0), nls_func_set)) {
+		return nls_aot_set(K(1), K(10), frame, out);
+	}
+	return nls_aot_apply(K(13), frame, out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(4), nls_func_mul)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(5), frame, &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_arg(K(6), frame, &v), v, i1);
+		return nls_aot_int(i0 * i1, out);
+	}
+	return nls_aot_apply(K(9), frame, out);
+}
+
+static int
+nls_aot_t3(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(15), out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(14)) != K(10)) {
+		return nls_aot_apply(K(17), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t3, K(15), frame);
+	return nls_aot_enter(nls_aot_t2, args, 1, NULL, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 18, nls_aot_exprs);
+}
@@ -0,0 +1,152 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[32];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 2, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_LIST, 8, -1, NULL},
+	{NLS_TYPE_LIST, 7, 9, NULL},
+	{NLS_TYPE_APPLICATION, 6, 10, NULL},
+	{NLS_TYPE_LIST, 11, -1, NULL},
+	{NLS_TYPE_LIST, 5, 12, NULL},
+	{NLS_TYPE_APPLICATION, 4, 13, NULL},
+	{NLS_TYPE_ABSTRACTION, 3, 14, NULL},
+	{NLS_TYPE_LIST, 15, -1, NULL},
+	{NLS_TYPE_LIST, 1, 16, NULL},
+	{NLS_TYPE_APPLICATION, 0, 17, NULL},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_INT, 1, 0, NULL},
+	{NLS_TYPE_LIST, 20, -1, NULL},
+	{NLS_TYPE_APPLICATION, 19, 21, NULL},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_LIST, 24, -1, NULL},
+	{NLS_TYPE_APPLICATION, 23, 25, NULL},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_LIST, 28, -1, NULL},
+	{NLS_TYPE_APPLICATION, 27, 29, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t3(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t5(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t4(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t7(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t6(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(0), nls_func_set)) {
+		return nls_aot_set(K(1), K(15), frame, out);
+	}
+	return nls_aot_apply(K(18), frame, out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(4), nls_func_mul)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(5), frame, &v), v, i0);
+		if (nls_aot_holds(K(6), nls_func_mul)) {
+			int i2, i3;
+
+			NLS_AOT_INT_OF(nls_aot_arg(K(7), frame, &v), v, i2);
+			NLS_AOT_INT_OF(nls_aot_arg(K(8), frame, &v), v, i3);
+			i1 = i2 * i3;
+		} else {
+			NLS_AOT_INT_OF(nls_aot_apply(K(11), frame, &v), v, i1);
+		}
+		return nls_aot_int(i0 * i1, out);
+	}
+	return nls_aot_apply(K(14), frame, out);
+}
+
+static int
+nls_aot_t3(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(20), out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(19)) != K(15)) {
+		return nls_aot_apply(K(22), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t3, K(20), frame);
+	return nls_aot_enter(nls_aot_t2, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t5(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(24), out);
+}
+
+static int
+nls_aot_t4(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(23)) != K(15)) {
+		return nls_aot_apply(K(26), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t5, K(24), frame);
+	return nls_aot_enter(nls_aot_t2, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t7(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(28), out);
+}
+
+static int
+nls_aot_t6(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(27)) != K(15)) {
+		return nls_aot_apply(K(30), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t7, K(28), frame);
+	return nls_aot_enter(nls_aot_t2, args, 1, NULL, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	nls_aot_t4,
+	nls_aot_t6,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 31, nls_aot_exprs);
+}
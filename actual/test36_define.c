@@ -0,0 +1,136 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[42];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "define"},
+	{NLS_TYPE_VAR, -1, 0, "name"},
+	{NLS_TYPE_VAR, -1, 0, "args"},
+	{NLS_TYPE_VAR, -1, 0, "expr"},
+	{NLS_TYPE_LIST, 4, -1, NULL},
+	{NLS_TYPE_LIST, 3, 5, NULL},
+	{NLS_TYPE_LIST, 2, 6, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, 0, 0, "name"},
+	{NLS_TYPE_VAR, -1, 0, "abst"},
+	{NLS_TYPE_VAR, 1, 0, "args"},
+	{NLS_TYPE_VAR, 2, 0, "expr"},
+	{NLS_TYPE_LIST, 12, -1, NULL},
+	{NLS_TYPE_LIST, 11, 13, NULL},
+	{NLS_TYPE_APPLICATION, 10, 14, NULL},
+	{NLS_TYPE_LIST, 15, -1, NULL},
+	{NLS_TYPE_LIST, 9, 16, NULL},
+	{NLS_TYPE_APPLICATION, 8, 17, NULL},
+	{NLS_TYPE_ABSTRACTION, 7, 18, NULL},
+	{NLS_TYPE_LIST, 19, -1, NULL},
+	{NLS_TYPE_LIST, 1, 20, NULL},
+	{NLS_TYPE_APPLICATION, 0, 21, NULL},
+	{NLS_TYPE_VAR, -1, 0, "define"},
+	{NLS_TYPE_VAR, -1, 0, "square"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 25, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 29, -1, NULL},
+	{NLS_TYPE_LIST, 28, 30, NULL},
+	{NLS_TYPE_APPLICATION, 27, 31, NULL},
+	{NLS_TYPE_LIST, 32, -1, NULL},
+	{NLS_TYPE_LIST, 26, 33, NULL},
+	{NLS_TYPE_LIST, 24, 34, NULL},
+	{NLS_TYPE_APPLICATION, 23, 35, NULL},
+	{NLS_TYPE_VAR, -1, 0, "square"},
+	{NLS_TYPE_INT, 5, 0, NULL},
+	{NLS_TYPE_LIST, 38, -1, NULL},
+	{NLS_TYPE_APPLICATION, 37, 39, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t3(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t4(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t5(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t6(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(0), nls_func_set)) {
+		return nls_aot_set(K(1), K(19), frame, out);
+	}
+	return nls_aot_apply(K(22), frame, out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(18), frame, out);
+}
+
+static int
+nls_aot_t3(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(24), out);
+}
+
+static int
+nls_aot_t4(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(26), out);
+}
+
+static int
+nls_aot_t5(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(27), nls_func_mul)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_global(K(28), &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_global(K(29), &v), v, i1);
+		return nls_aot_int(i0 * i1, out);
+	}
+	return nls_aot_apply(K(32), frame, out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[3];
+
+	if (nls_symbol_get(K(23)) != K(19)) {
+		return nls_aot_apply(K(36), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t3, K(24), frame);
+	nls_aot_thunk_init(&args[1], nls_aot_t4, K(26), frame);
+	nls_aot_thunk_init(&args[2], nls_aot_t5, K(32), frame);
+	return nls_aot_enter(nls_aot_t2, args, 3, NULL, out);
+}
+
+static int
+nls_aot_t6(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(40), frame, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	nls_aot_t6,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 41, nls_aot_exprs);
+}
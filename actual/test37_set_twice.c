@@ -0,0 +1,169 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[42];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "a"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 2, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_LIST, 6, -1, NULL},
+	{NLS_TYPE_LIST, 5, 7, NULL},
+	{NLS_TYPE_APPLICATION, 4, 8, NULL},
+	{NLS_TYPE_ABSTRACTION, 3, 9, NULL},
+	{NLS_TYPE_LIST, 10, -1, NULL},
+	{NLS_TYPE_LIST, 1, 11, NULL},
+	{NLS_TYPE_APPLICATION, 0, 12, NULL},
+	{NLS_TYPE_VAR, -1, 0, "a"},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_LIST, 15, -1, NULL},
+	{NLS_TYPE_APPLICATION, 14, 16, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "a"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 20, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_LIST, 25, -1, NULL},
+	{NLS_TYPE_LIST, 24, 26, NULL},
+	{NLS_TYPE_APPLICATION, 23, 27, NULL},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_LIST, 29, -1, NULL},
+	{NLS_TYPE_LIST, 28, 30, NULL},
+	{NLS_TYPE_APPLICATION, 22, 31, NULL},
+	{NLS_TYPE_ABSTRACTION, 21, 32, NULL},
+	{NLS_TYPE_LIST, 33, -1, NULL},
+	{NLS_TYPE_LIST, 19, 34, NULL},
+	{NLS_TYPE_APPLICATION, 18, 35, NULL},
+	{NLS_TYPE_VAR, -1, 0, "a"},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_LIST, 38, -1, NULL},
+	{NLS_TYPE_APPLICATION, 37, 39, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t3(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t4(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t6(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t7(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t5(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(0), nls_func_set)) {
+		return nls_aot_set(K(1), K(10), frame, out);
+	}
+	return nls_aot_apply(K(13), frame, out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(4), nls_func_mul)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(5), frame, &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_arg(K(6), frame, &v), v, i1);
+		return nls_aot_int(i0 * i1, out);
+	}
+	return nls_aot_apply(K(9), frame, out);
+}
+
+static int
+nls_aot_t3(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(15), out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(14)) != K(10)) {
+		return nls_aot_apply(K(17), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t3, K(15), frame);
+	return nls_aot_enter(nls_aot_t2, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t4(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(18), nls_func_set)) {
+		return nls_aot_set(K(19), K(33), frame, out);
+	}
+	return nls_aot_apply(K(36), frame, out);
+}
+
+static int
+nls_aot_t6(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(22), nls_func_mul)) {
+		int i0, i1;
+
+		if (nls_aot_holds(K(23), nls_func_mul)) {
+			int i2, i3;
+
+			NLS_AOT_INT_OF(nls_aot_arg(K(24), frame, &v), v, i2);
+			NLS_AOT_INT_OF(nls_aot_arg(K(25), frame, &v), v, i3);
+			i0 = i2 * i3;
+		} else {
+			NLS_AOT_INT_OF(nls_aot_apply(K(28), frame, &v), v, i0);
+		}
+		NLS_AOT_INT_OF(nls_aot_arg(K(29), frame, &v), v, i1);
+		return nls_aot_int(i0 * i1, out);
+	}
+	return nls_aot_apply(K(32), frame, out);
+}
+
+static int
+nls_aot_t7(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(38), out);
+}
+
+static int
+nls_aot_t5(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(37)) != K(33)) {
+		return nls_aot_apply(K(40), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t7, K(38), frame);
+	return nls_aot_enter(nls_aot_t6, args, 1, NULL, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	nls_aot_t4,
+	nls_aot_t5,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 41, nls_aot_exprs);
+}
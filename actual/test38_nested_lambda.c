@@ -0,0 +1,97 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[29];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "multiplier"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 2, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "y"},
+	{NLS_TYPE_LIST, 4, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 1, 0, "x"},
+	{NLS_TYPE_VAR, 0, 0, "y"},
+	{NLS_TYPE_LIST, 8, -1, NULL},
+	{NLS_TYPE_LIST, 7, 9, NULL},
+	{NLS_TYPE_APPLICATION, 6, 10, NULL},
+	{NLS_TYPE_ABSTRACTION, 5, 11, NULL},
+	{NLS_TYPE_ABSTRACTION, 3, 12, NULL},
+	{NLS_TYPE_LIST, 13, -1, NULL},
+	{NLS_TYPE_LIST, 1, 14, NULL},
+	{NLS_TYPE_APPLICATION, 0, 15, NULL},
+	{NLS_TYPE_VAR, -1, 0, "multiplier"},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_LIST, 18, -1, NULL},
+	{NLS_TYPE_APPLICATION, 17, 19, NULL},
+	{NLS_TYPE_VAR, -1, 0, "multiplier"},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_LIST, 22, -1, NULL},
+	{NLS_TYPE_APPLICATION, 21, 23, NULL},
+	{NLS_TYPE_INT, 4, 0, NULL},
+	{NLS_TYPE_LIST, 25, -1, NULL},
+	{NLS_TYPE_APPLICATION, 24, 26, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t3(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t4(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(0), nls_func_set)) {
+		return nls_aot_set(K(1), K(13), frame, out);
+	}
+	return nls_aot_apply(K(16), frame, out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_inst(K(12), frame, out);
+}
+
+static int
+nls_aot_t3(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(18), out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(17)) != K(13)) {
+		return nls_aot_apply(K(20), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t3, K(18), frame);
+	return nls_aot_enter(nls_aot_t2, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t4(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(27), frame, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	nls_aot_t4,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 28, nls_aot_exprs);
+}
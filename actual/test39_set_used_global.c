@@ -0,0 +1,148 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[34];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 2, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_LIST, 6, -1, NULL},
+	{NLS_TYPE_LIST, 5, 7, NULL},
+	{NLS_TYPE_APPLICATION, 4, 8, NULL},
+	{NLS_TYPE_ABSTRACTION, 3, 9, NULL},
+	{NLS_TYPE_LIST, 10, -1, NULL},
+	{NLS_TYPE_LIST, 1, 11, NULL},
+	{NLS_TYPE_APPLICATION, 0, 12, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_INT, 1, 0, NULL},
+	{NLS_TYPE_LIST, 16, -1, NULL},
+	{NLS_TYPE_LIST, 15, 17, NULL},
+	{NLS_TYPE_APPLICATION, 14, 18, NULL},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_LIST, 16, -1, NULL},
+	{NLS_TYPE_APPLICATION, 20, 21, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_INT, 10, 0, NULL},
+	{NLS_TYPE_LIST, 25, -1, NULL},
+	{NLS_TYPE_LIST, 24, 26, NULL},
+	{NLS_TYPE_APPLICATION, 23, 27, NULL},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_LIST, 16, -1, NULL},
+	{NLS_TYPE_APPLICATION, 29, 30, NULL},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t3(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t4(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t5(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t6(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t7(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(0), nls_func_set)) {
+		return nls_aot_set(K(1), K(10), frame, out);
+	}
+	return nls_aot_apply(K(13), frame, out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(14), nls_func_set)) {
+		return nls_aot_set(K(15), K(16), frame, out);
+	}
+	return nls_aot_apply(K(19), frame, out);
+}
+
+static int
+nls_aot_t3(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(4), nls_func_add)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(5), frame, &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_global(K(6), &v), v, i1);
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(9), frame, out);
+}
+
+static int
+nls_aot_t4(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(16), out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(20)) != K(10)) {
+		return nls_aot_apply(K(22), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t4, K(16), frame);
+	return nls_aot_enter(nls_aot_t3, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t5(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(23), nls_func_set)) {
+		return nls_aot_set(K(24), K(25), frame, out);
+	}
+	return nls_aot_apply(K(28), frame, out);
+}
+
+static int
+nls_aot_t6(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(29)) != K(10)) {
+		return nls_aot_apply(K(31), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t4, K(16), frame);
+	return nls_aot_enter(nls_aot_t3, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t7(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(32), out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	nls_aot_t2,
+	nls_aot_t5,
+	nls_aot_t6,
+	nls_aot_t7,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 33, nls_aot_exprs);
+}
@@ -0,0 +1,145 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[57];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 0, -1, NULL},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_ABSTRACTION, 1, 2, NULL},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_LIST, 4, -1, NULL},
+	{NLS_TYPE_APPLICATION, 3, 5, NULL},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "y"},
+	{NLS_TYPE_LIST, 8, -1, NULL},
+	{NLS_TYPE_LIST, 7, 9, NULL},
+	{NLS_TYPE_VAR, 1, 0, "y"},
+	{NLS_TYPE_ABSTRACTION, 10, 11, NULL},
+	{NLS_TYPE_INT, 4, 0, NULL},
+	{NLS_TYPE_LIST, 13, -1, NULL},
+	{NLS_TYPE_LIST, 4, 14, NULL},
+	{NLS_TYPE_APPLICATION, 12, 15, NULL},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "y"},
+	{NLS_TYPE_LIST, 18, -1, NULL},
+	{NLS_TYPE_LIST, 17, 19, NULL},
+	{NLS_TYPE_VAR, -1, 0, "z"},
+	{NLS_TYPE_LIST, 21, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 1, 0, "x"},
+	{NLS_TYPE_VAR, 0, 0, "z"},
+	{NLS_TYPE_LIST, 26, -1, NULL},
+	{NLS_TYPE_LIST, 25, 27, NULL},
+	{NLS_TYPE_APPLICATION, 24, 28, NULL},
+	{NLS_TYPE_VAR, 2, 0, "y"},
+	{NLS_TYPE_LIST, 30, -1, NULL},
+	{NLS_TYPE_LIST, 29, 31, NULL},
+	{NLS_TYPE_APPLICATION, 23, 32, NULL},
+	{NLS_TYPE_ABSTRACTION, 22, 33, NULL},
+	{NLS_TYPE_ABSTRACTION, 20, 34, NULL},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_INT, 5, 0, NULL},
+	{NLS_TYPE_LIST, 37, -1, NULL},
+	{NLS_TYPE_LIST, 36, 38, NULL},
+	{NLS_TYPE_APPLICATION, 35, 39, NULL},
+	{NLS_TYPE_INT, 7, 0, NULL},
+	{NLS_TYPE_LIST, 41, -1, NULL},
+	{NLS_TYPE_APPLICATION, 40, 42, NULL},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 44, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 46, -1, NULL},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_ABSTRACTION, 47, 48, NULL},
+	{NLS_TYPE_ABSTRACTION, 45, 49, NULL},
+	{NLS_TYPE_INT, 1, 0, NULL},
+	{NLS_TYPE_LIST, 51, -1, NULL},
+	{NLS_TYPE_APPLICATION, 50, 52, NULL},
+	{NLS_TYPE_LIST, 36, -1, NULL},
+	{NLS_TYPE_APPLICATION, 53, 54, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t4(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t5(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t3(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t6(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t7(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_arg(K(2), frame, out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(4), out);
+}
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	nls_aot_thunk_init(&args[0], nls_aot_t2, K(4), frame);
+	return nls_aot_enter(nls_aot_t1, args, 1, frame, out);
+}
+
+static int
+nls_aot_t4(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_arg(K(11), frame, out);
+}
+
+static int
+nls_aot_t5(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(13), out);
+}
+
+static int
+nls_aot_t3(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[2];
+
+	nls_aot_thunk_init(&args[0], nls_aot_t2, K(4), frame);
+	nls_aot_thunk_init(&args[1], nls_aot_t5, K(13), frame);
+	return nls_aot_enter(nls_aot_t4, args, 2, frame, out);
+}
+
+static int
+nls_aot_t6(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(43), frame, out);
+}
+
+static int
+nls_aot_t7(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(55), frame, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t3,
+	nls_aot_t6,
+	nls_aot_t7,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 56, nls_aot_exprs);
+}
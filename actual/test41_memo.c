@@ -0,0 +1,454 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[114];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 2, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_LIST, 8, -1, NULL},
+	{NLS_TYPE_LIST, 7, 9, NULL},
+	{NLS_TYPE_APPLICATION, 6, 10, NULL},
+	{NLS_TYPE_LIST, 11, -1, NULL},
+	{NLS_TYPE_LIST, 5, 12, NULL},
+	{NLS_TYPE_APPLICATION, 4, 13, NULL},
+	{NLS_TYPE_ABSTRACTION, 3, 14, NULL},
+	{NLS_TYPE_LIST, 15, -1, NULL},
+	{NLS_TYPE_LIST, 1, 16, NULL},
+	{NLS_TYPE_APPLICATION, 0, 17, NULL},
+	{NLS_TYPE_VAR, -1, 0, "memo"},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_LIST, 20, -1, NULL},
+	{NLS_TYPE_APPLICATION, 19, 21, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_LIST, 25, -1, NULL},
+	{NLS_TYPE_APPLICATION, 24, 26, NULL},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_LIST, 25, -1, NULL},
+	{NLS_TYPE_APPLICATION, 28, 29, NULL},
+	{NLS_TYPE_LIST, 30, -1, NULL},
+	{NLS_TYPE_LIST, 27, 31, NULL},
+	{NLS_TYPE_APPLICATION, 23, 32, NULL},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_INT, 1, 0, NULL},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_LIST, 37, -1, NULL},
+	{NLS_TYPE_LIST, 36, 38, NULL},
+	{NLS_TYPE_APPLICATION, 35, 39, NULL},
+	{NLS_TYPE_LIST, 40, -1, NULL},
+	{NLS_TYPE_APPLICATION, 34, 41, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_LIST, 36, -1, NULL},
+	{NLS_TYPE_LIST, 44, 45, NULL},
+	{NLS_TYPE_APPLICATION, 43, 46, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 50, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_LIST, 54, -1, NULL},
+	{NLS_TYPE_LIST, 53, 55, NULL},
+	{NLS_TYPE_APPLICATION, 52, 56, NULL},
+	{NLS_TYPE_ABSTRACTION, 51, 57, NULL},
+	{NLS_TYPE_LIST, 58, -1, NULL},
+	{NLS_TYPE_LIST, 49, 59, NULL},
+	{NLS_TYPE_APPLICATION, 48, 60, NULL},
+	{NLS_TYPE_VAR, -1, 0, "memo"},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_LIST, 63, -1, NULL},
+	{NLS_TYPE_APPLICATION, 62, 64, NULL},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_LIST, 36, -1, NULL},
+	{NLS_TYPE_APPLICATION, 66, 67, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_INT, 10, 0, NULL},
+	{NLS_TYPE_LIST, 71, -1, NULL},
+	{NLS_TYPE_LIST, 70, 72, NULL},
+	{NLS_TYPE_APPLICATION, 69, 73, NULL},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_LIST, 36, -1, NULL},
+	{NLS_TYPE_APPLICATION, 75, 76, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "y"},
+	{NLS_TYPE_LIST, 81, -1, NULL},
+	{NLS_TYPE_LIST, 80, 82, NULL},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_ABSTRACTION, 83, 84, NULL},
+	{NLS_TYPE_LIST, 85, -1, NULL},
+	{NLS_TYPE_LIST, 79, 86, NULL},
+	{NLS_TYPE_APPLICATION, 78, 87, NULL},
+	{NLS_TYPE_VAR, -1, 0, "memo"},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_LIST, 90, -1, NULL},
+	{NLS_TYPE_APPLICATION, 89, 91, NULL},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_VAR, -1, 0, "div"},
+	{NLS_TYPE_VAR, -1, 0, "sub"},
+	{NLS_TYPE_LIST, 37, -1, NULL},
+	{NLS_TYPE_LIST, 37, 96, NULL},
+	{NLS_TYPE_APPLICATION, 95, 97, NULL},
+	{NLS_TYPE_LIST, 98, -1, NULL},
+	{NLS_TYPE_LIST, 36, 99, NULL},
+	{NLS_TYPE_APPLICATION, 94, 100, NULL},
+	{NLS_TYPE_LIST, 101, -1, NULL},
+	{NLS_TYPE_LIST, 36, 102, NULL},
+	{NLS_TYPE_APPLICATION, 93, 103, NULL},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_LIST, 37, -1, NULL},
+	{NLS_TYPE_LIST, 36, 106, NULL},
+	{NLS_TYPE_APPLICATION, 105, 107, NULL},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_LIST, 37, -1, NULL},
+	{NLS_TYPE_LIST, 36, 110, NULL},
+	{NLS_TYPE_APPLICATION, 109, 111, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t4(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t5(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t3(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t6(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t8(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t7(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t9(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t10(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t11(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t13(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t14(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t12(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t15(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t16(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t17(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t18(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t20(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t21(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t19(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t23(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t22(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t24(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(0), nls_func_set)) {
+		return nls_aot_set(K(1), K(15), frame, out);
+	}
+	return nls_aot_apply(K(18), frame, out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(22), frame, out);
+}
+
+static int
+nls_aot_t4(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(4), nls_func_mul)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(5), frame, &v), v, i0);
+		if (nls_aot_holds(K(6), nls_func_mul)) {
+			int i2, i3;
+
+			NLS_AOT_INT_OF(nls_aot_arg(K(7), frame, &v), v, i2);
+			NLS_AOT_INT_OF(nls_aot_arg(K(8), frame, &v), v, i3);
+			i1 = i2 * i3;
+		} else {
+			NLS_AOT_INT_OF(nls_aot_apply(K(11), frame, &v), v, i1);
+		}
+		return nls_aot_int(i0 * i1, out);
+	}
+	return nls_aot_apply(K(14), frame, out);
+}
+
+static int
+nls_aot_t5(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(25), out);
+}
+
+static int
+nls_aot_t3(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(24)) != K(15)) {
+		return nls_aot_apply(K(27), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t5, K(25), frame);
+	return nls_aot_enter(nls_aot_t4, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t6(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(28)) != K(15)) {
+		return nls_aot_apply(K(30), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t5, K(25), frame);
+	return nls_aot_enter(nls_aot_t4, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(23), nls_func_add)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_t3(frame, &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_t6(frame, &v), v, i1);
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(33), frame, out);
+}
+
+static int
+nls_aot_t8(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(35), nls_func_add)) {
+		int i0, i1;
+
+		i0 = 1;
+		i1 = 2;
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(40), frame, out);
+}
+
+static int
+nls_aot_t7(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(34)) != K(15)) {
+		return nls_aot_apply(K(42), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t8, K(40), frame);
+	return nls_aot_enter(nls_aot_t4, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t9(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(43), nls_func_set)) {
+		return nls_aot_set(K(44), K(36), frame, out);
+	}
+	return nls_aot_apply(K(47), frame, out);
+}
+
+static int
+nls_aot_t10(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(48), nls_func_set)) {
+		return nls_aot_set(K(49), K(58), frame, out);
+	}
+	return nls_aot_apply(K(61), frame, out);
+}
+
+static int
+nls_aot_t11(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(65), frame, out);
+}
+
+static int
+nls_aot_t13(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(52), nls_func_add)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(53), frame, &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_global(K(54), &v), v, i1);
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(57), frame, out);
+}
+
+static int
+nls_aot_t14(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(36), out);
+}
+
+static int
+nls_aot_t12(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(66)) != K(58)) {
+		return nls_aot_apply(K(68), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t14, K(36), frame);
+	return nls_aot_enter(nls_aot_t13, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t15(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(69), nls_func_set)) {
+		return nls_aot_set(K(70), K(71), frame, out);
+	}
+	return nls_aot_apply(K(74), frame, out);
+}
+
+static int
+nls_aot_t16(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(75)) != K(58)) {
+		return nls_aot_apply(K(77), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t14, K(36), frame);
+	return nls_aot_enter(nls_aot_t13, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t17(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(78), nls_func_set)) {
+		return nls_aot_set(K(79), K(85), frame, out);
+	}
+	return nls_aot_apply(K(88), frame, out);
+}
+
+static int
+nls_aot_t18(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(92), frame, out);
+}
+
+static int
+nls_aot_t20(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_arg(K(84), frame, out);
+}
+
+static int
+nls_aot_t21(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(94), nls_func_div)) {
+		int i0, i1;
+
+		i0 = 1;
+		if (nls_aot_holds(K(95), nls_func_sub)) {
+			int i2, i3;
+
+			i2 = 2;
+			i3 = 2;
+			i1 = i2 - i3;
+		} else {
+			NLS_AOT_INT_OF(nls_aot_apply(K(98), frame, &v), v, i1);
+		}
+		return nls_aot_int(i0 / i1, out);
+	}
+	return nls_aot_apply(K(101), frame, out);
+}
+
+static int
+nls_aot_t19(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[2];
+
+	if (nls_symbol_get(K(93)) != K(85)) {
+		return nls_aot_apply(K(104), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t14, K(36), frame);
+	nls_aot_thunk_init(&args[1], nls_aot_t21, K(101), frame);
+	return nls_aot_enter(nls_aot_t20, args, 2, NULL, out);
+}
+
+static int
+nls_aot_t23(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(37), out);
+}
+
+static int
+nls_aot_t22(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[2];
+
+	if (nls_symbol_get(K(105)) != K(85)) {
+		return nls_aot_apply(K(108), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t14, K(36), frame);
+	nls_aot_thunk_init(&args[1], nls_aot_t23, K(37), frame);
+	return nls_aot_enter(nls_aot_t20, args, 2, NULL, out);
+}
+
+static int
+nls_aot_t24(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[2];
+
+	if (nls_symbol_get(K(109)) != K(85)) {
+		return nls_aot_apply(K(112), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t14, K(36), frame);
+	nls_aot_thunk_init(&args[1], nls_aot_t23, K(37), frame);
+	return nls_aot_enter(nls_aot_t20, args, 2, NULL, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	nls_aot_t2,
+	nls_aot_t7,
+	nls_aot_t9,
+	nls_aot_t10,
+	nls_aot_t11,
+	nls_aot_t12,
+	nls_aot_t15,
+	nls_aot_t16,
+	nls_aot_t17,
+	nls_aot_t18,
+	nls_aot_t19,
+	nls_aot_t22,
+	nls_aot_t24,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 113, nls_aot_exprs);
+}
@@ -0,0 +1,748 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[237];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 2, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_LIST, 8, -1, NULL},
+	{NLS_TYPE_LIST, 7, 9, NULL},
+	{NLS_TYPE_APPLICATION, 6, 10, NULL},
+	{NLS_TYPE_LIST, 11, -1, NULL},
+	{NLS_TYPE_LIST, 5, 12, NULL},
+	{NLS_TYPE_APPLICATION, 4, 13, NULL},
+	{NLS_TYPE_ABSTRACTION, 3, 14, NULL},
+	{NLS_TYPE_LIST, 15, -1, NULL},
+	{NLS_TYPE_LIST, 1, 16, NULL},
+	{NLS_TYPE_APPLICATION, 0, 17, NULL},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_INT, 1, 0, NULL},
+	{NLS_TYPE_LIST, 20, -1, NULL},
+	{NLS_TYPE_APPLICATION, 19, 21, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "g"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 25, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "y"},
+	{NLS_TYPE_VAR, -1, 0, "z"},
+	{NLS_TYPE_LIST, 30, -1, NULL},
+	{NLS_TYPE_LIST, 29, 31, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "y"},
+	{NLS_TYPE_VAR, 1, 0, "z"},
+	{NLS_TYPE_LIST, 35, -1, NULL},
+	{NLS_TYPE_LIST, 34, 36, NULL},
+	{NLS_TYPE_APPLICATION, 33, 37, NULL},
+	{NLS_TYPE_ABSTRACTION, 32, 38, NULL},
+	{NLS_TYPE_LIST, 8, -1, NULL},
+	{NLS_TYPE_LIST, 7, 40, NULL},
+	{NLS_TYPE_APPLICATION, 39, 41, NULL},
+	{NLS_TYPE_LIST, 42, -1, NULL},
+	{NLS_TYPE_LIST, 28, 43, NULL},
+	{NLS_TYPE_APPLICATION, 27, 44, NULL},
+	{NLS_TYPE_ABSTRACTION, 26, 45, NULL},
+	{NLS_TYPE_LIST, 46, -1, NULL},
+	{NLS_TYPE_LIST, 24, 47, NULL},
+	{NLS_TYPE_APPLICATION, 23, 48, NULL},
+	{NLS_TYPE_VAR, -1, 0, "g"},
+	{NLS_TYPE_LIST, 20, -1, NULL},
+	{NLS_TYPE_APPLICATION, 50, 51, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "h"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 55, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_LIST, 7, -1, NULL},
+	{NLS_TYPE_APPLICATION, 57, 58, NULL},
+	{NLS_TYPE_LIST, 8, -1, NULL},
+	{NLS_TYPE_APPLICATION, 59, 60, NULL},
+	{NLS_TYPE_ABSTRACTION, 56, 61, NULL},
+	{NLS_TYPE_LIST, 62, -1, NULL},
+	{NLS_TYPE_LIST, 54, 63, NULL},
+	{NLS_TYPE_APPLICATION, 53, 64, NULL},
+	{NLS_TYPE_VAR, -1, 0, "h"},
+	{NLS_TYPE_LIST, 20, -1, NULL},
+	{NLS_TYPE_APPLICATION, 66, 67, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_LIST, 7, -1, NULL},
+	{NLS_TYPE_APPLICATION, 69, 70, NULL},
+	{NLS_TYPE_LIST, 8, -1, NULL},
+	{NLS_TYPE_APPLICATION, 71, 72, NULL},
+	{NLS_TYPE_VAR, -1, 0, "y"},
+	{NLS_TYPE_VAR, -1, 0, "z"},
+	{NLS_TYPE_LIST, 75, -1, NULL},
+	{NLS_TYPE_LIST, 74, 76, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "y"},
+	{NLS_TYPE_VAR, 1, 0, "z"},
+	{NLS_TYPE_LIST, 80, -1, NULL},
+	{NLS_TYPE_LIST, 79, 81, NULL},
+	{NLS_TYPE_APPLICATION, 78, 82, NULL},
+	{NLS_TYPE_ABSTRACTION, 77, 83, NULL},
+	{NLS_TYPE_LIST, 8, -1, NULL},
+	{NLS_TYPE_LIST, 7, 85, NULL},
+	{NLS_TYPE_APPLICATION, 84, 86, NULL},
+	{NLS_TYPE_VAR, -1, 0, "y"},
+	{NLS_TYPE_VAR, -1, 0, "z"},
+	{NLS_TYPE_LIST, 89, -1, NULL},
+	{NLS_TYPE_LIST, 88, 90, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "y"},
+	{NLS_TYPE_VAR, 1, 0, "z"},
+	{NLS_TYPE_LIST, 94, -1, NULL},
+	{NLS_TYPE_LIST, 93, 95, NULL},
+	{NLS_TYPE_APPLICATION, 92, 96, NULL},
+	{NLS_TYPE_ABSTRACTION, 91, 97, NULL},
+	{NLS_TYPE_LIST, 7, -1, NULL},
+	{NLS_TYPE_APPLICATION, 98, 99, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_LIST, 8, -1, NULL},
+	{NLS_TYPE_LIST, 7, 104, NULL},
+	{NLS_TYPE_APPLICATION, 103, 105, NULL},
+	{NLS_TYPE_LIST, 106, -1, NULL},
+	{NLS_TYPE_LIST, 102, 107, NULL},
+	{NLS_TYPE_APPLICATION, 101, 108, NULL},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "d"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 113, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "div"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "sub"},
+	{NLS_TYPE_LIST, 7, -1, NULL},
+	{NLS_TYPE_LIST, 7, 118, NULL},
+	{NLS_TYPE_APPLICATION, 117, 119, NULL},
+	{NLS_TYPE_LIST, 120, -1, NULL},
+	{NLS_TYPE_LIST, 116, 121, NULL},
+	{NLS_TYPE_APPLICATION, 115, 122, NULL},
+	{NLS_TYPE_ABSTRACTION, 114, 123, NULL},
+	{NLS_TYPE_LIST, 124, -1, NULL},
+	{NLS_TYPE_LIST, 112, 125, NULL},
+	{NLS_TYPE_APPLICATION, 111, 126, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_LIST, 8, -1, NULL},
+	{NLS_TYPE_LIST, 7, 130, NULL},
+	{NLS_TYPE_APPLICATION, 129, 131, NULL},
+	{NLS_TYPE_LIST, 132, -1, NULL},
+	{NLS_TYPE_LIST, 20, 133, NULL},
+	{NLS_TYPE_APPLICATION, 128, 134, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_LIST, 138, -1, NULL},
+	{NLS_TYPE_LIST, 137, 139, NULL},
+	{NLS_TYPE_APPLICATION, 136, 140, NULL},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_LIST, 20, -1, NULL},
+	{NLS_TYPE_APPLICATION, 142, 143, NULL},
+	{NLS_TYPE_VAR, -1, 0, "g"},
+	{NLS_TYPE_LIST, 20, -1, NULL},
+	{NLS_TYPE_APPLICATION, 145, 146, NULL},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_LIST, 8, -1, NULL},
+	{NLS_TYPE_LIST, 7, 150, NULL},
+	{NLS_TYPE_APPLICATION, 149, 151, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "q"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 155, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "sub"},
+	{NLS_TYPE_INT, 5, 0, NULL},
+	{NLS_TYPE_INT, 4, 0, NULL},
+	{NLS_TYPE_LIST, 161, -1, NULL},
+	{NLS_TYPE_LIST, 160, 162, NULL},
+	{NLS_TYPE_APPLICATION, 159, 163, NULL},
+	{NLS_TYPE_LIST, 164, -1, NULL},
+	{NLS_TYPE_LIST, 158, 165, NULL},
+	{NLS_TYPE_APPLICATION, 157, 166, NULL},
+	{NLS_TYPE_ABSTRACTION, 156, 167, NULL},
+	{NLS_TYPE_LIST, 168, -1, NULL},
+	{NLS_TYPE_LIST, 154, 169, NULL},
+	{NLS_TYPE_APPLICATION, 153, 170, NULL},
+	{NLS_TYPE_VAR, -1, 0, "q"},
+	{NLS_TYPE_LIST, 20, -1, NULL},
+	{NLS_TYPE_APPLICATION, 172, 173, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "r"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 177, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "sub"},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_LIST, 181, -1, NULL},
+	{NLS_TYPE_LIST, 180, 182, NULL},
+	{NLS_TYPE_APPLICATION, 179, 183, NULL},
+	{NLS_TYPE_ABSTRACTION, 178, 184, NULL},
+	{NLS_TYPE_LIST, 185, -1, NULL},
+	{NLS_TYPE_LIST, 176, 186, NULL},
+	{NLS_TYPE_APPLICATION, 175, 187, NULL},
+	{NLS_TYPE_VAR, -1, 0, "q"},
+	{NLS_TYPE_LIST, 20, -1, NULL},
+	{NLS_TYPE_APPLICATION, 189, 190, NULL},
+	{NLS_TYPE_VAR, -1, 0, "r"},
+	{NLS_TYPE_LIST, 20, -1, NULL},
+	{NLS_TYPE_APPLICATION, 192, 193, NULL},
+	{NLS_TYPE_VAR, -1, 0, "q"},
+	{NLS_TYPE_LIST, 20, -1, NULL},
+	{NLS_TYPE_APPLICATION, 195, 196, NULL},
+	{NLS_TYPE_VAR, -1, 0, "sub"},
+	{NLS_TYPE_LIST, 161, -1, NULL},
+	{NLS_TYPE_LIST, 160, 199, NULL},
+	{NLS_TYPE_APPLICATION, 198, 200, NULL},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 202, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "y"},
+	{NLS_TYPE_LIST, 204, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 1, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "y"},
+	{NLS_TYPE_LIST, 7, -1, NULL},
+	{NLS_TYPE_LIST, 209, 210, NULL},
+	{NLS_TYPE_APPLICATION, 208, 211, NULL},
+	{NLS_TYPE_LIST, 212, -1, NULL},
+	{NLS_TYPE_LIST, 207, 213, NULL},
+	{NLS_TYPE_APPLICATION, 206, 214, NULL},
+	{NLS_TYPE_ABSTRACTION, 205, 215, NULL},
+	{NLS_TYPE_ABSTRACTION, 203, 216, NULL},
+	{NLS_TYPE_LIST, 20, -1, NULL},
+	{NLS_TYPE_APPLICATION, 217, 218, NULL},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 220, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "y"},
+	{NLS_TYPE_LIST, 222, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 1, 0, "x"},
+	{NLS_TYPE_VAR, 0, 0, "y"},
+	{NLS_TYPE_LIST, 226, -1, NULL},
+	{NLS_TYPE_LIST, 225, 227, NULL},
+	{NLS_TYPE_APPLICATION, 224, 228, NULL},
+	{NLS_TYPE_ABSTRACTION, 223, 229, NULL},
+	{NLS_TYPE_ABSTRACTION, 221, 230, NULL},
+	{NLS_TYPE_LIST, 20, -1, NULL},
+	{NLS_TYPE_APPLICATION, 231, 232, NULL},
+	{NLS_TYPE_LIST, 7, -1, NULL},
+	{NLS_TYPE_APPLICATION, 233, 234, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t3(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t4(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t8(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t9(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t10(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t7(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t6(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t5(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t11(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t13(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t12(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t14(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t16(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t15(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t17(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t18(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t19(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t20(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t21(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t22(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t23(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t24(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t25(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t26(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t27(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t29(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t28(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t30(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t31(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t33(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t32(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t34(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t35(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t37(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t36(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t38(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(0), nls_func_set)) {
+		return nls_aot_set(K(1), K(15), frame, out);
+	}
+	return nls_aot_apply(K(18), frame, out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(4), nls_func_add)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(5), frame, &v), v, i0);
+		if (nls_aot_holds(K(6), nls_func_mul)) {
+			int i2, i3;
+
+			i2 = 2;
+			i3 = 3;
+			i1 = i2 * i3;
+		} else {
+			NLS_AOT_INT_OF(nls_aot_apply(K(11), frame, &v), v, i1);
+		}
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(14), frame, out);
+}
+
+static int
+nls_aot_t3(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(20), out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(19)) != K(15)) {
+		return nls_aot_apply(K(22), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t3, K(20), frame);
+	return nls_aot_enter(nls_aot_t2, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t4(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(23), nls_func_set)) {
+		return nls_aot_set(K(24), K(46), frame, out);
+	}
+	return nls_aot_apply(K(49), frame, out);
+}
+
+static int
+nls_aot_t8(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(33), nls_func_mul)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(34), frame, &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_arg(K(35), frame, &v), v, i1);
+		return nls_aot_int(i0 * i1, out);
+	}
+	return nls_aot_apply(K(38), frame, out);
+}
+
+static int
+nls_aot_t9(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(7), out);
+}
+
+static int
+nls_aot_t10(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(8), out);
+}
+
+static int
+nls_aot_t7(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[2];
+
+	nls_aot_thunk_init(&args[0], nls_aot_t9, K(7), frame);
+	nls_aot_thunk_init(&args[1], nls_aot_t10, K(8), frame);
+	return nls_aot_enter(nls_aot_t8, args, 2, frame, out);
+}
+
+static int
+nls_aot_t6(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(27), nls_func_add)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(28), frame, &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_t7(frame, &v), v, i1);
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(45), frame, out);
+}
+
+static int
+nls_aot_t5(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(50)) != K(46)) {
+		return nls_aot_apply(K(52), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t3, K(20), frame);
+	return nls_aot_enter(nls_aot_t6, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t11(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(53), nls_func_set)) {
+		return nls_aot_set(K(54), K(62), frame, out);
+	}
+	return nls_aot_apply(K(65), frame, out);
+}
+
+static int
+nls_aot_t13(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(61), frame, out);
+}
+
+static int
+nls_aot_t12(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(66)) != K(62)) {
+		return nls_aot_apply(K(68), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t3, K(20), frame);
+	return nls_aot_enter(nls_aot_t13, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t14(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(73), frame, out);
+}
+
+static int
+nls_aot_t16(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(78), nls_func_mul)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(79), frame, &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_arg(K(80), frame, &v), v, i1);
+		return nls_aot_int(i0 * i1, out);
+	}
+	return nls_aot_apply(K(83), frame, out);
+}
+
+static int
+nls_aot_t15(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[2];
+
+	nls_aot_thunk_init(&args[0], nls_aot_t9, K(7), frame);
+	nls_aot_thunk_init(&args[1], nls_aot_t10, K(8), frame);
+	return nls_aot_enter(nls_aot_t16, args, 2, frame, out);
+}
+
+static int
+nls_aot_t17(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(100), frame, out);
+}
+
+static int
+nls_aot_t18(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(101), nls_func_set)) {
+		return nls_aot_set(K(102), K(106), frame, out);
+	}
+	return nls_aot_apply(K(109), frame, out);
+}
+
+static int
+nls_aot_t19(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(110), out);
+}
+
+static int
+nls_aot_t20(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(111), nls_func_set)) {
+		return nls_aot_set(K(112), K(124), frame, out);
+	}
+	return nls_aot_apply(K(127), frame, out);
+}
+
+static int
+nls_aot_t21(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(128), nls_func_add)) {
+		int i0, i1;
+
+		i0 = 1;
+		if (nls_aot_holds(K(129), nls_func_mul)) {
+			int i2, i3;
+
+			i2 = 2;
+			i3 = 3;
+			i1 = i2 * i3;
+		} else {
+			NLS_AOT_INT_OF(nls_aot_apply(K(132), frame, &v), v, i1);
+		}
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(135), frame, out);
+}
+
+static int
+nls_aot_t22(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(136), nls_func_set)) {
+		return nls_aot_set(K(137), K(138), frame, out);
+	}
+	return nls_aot_apply(K(141), frame, out);
+}
+
+static int
+nls_aot_t23(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(142)) != K(15)) {
+		return nls_aot_apply(K(144), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t3, K(20), frame);
+	return nls_aot_enter(nls_aot_t2, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t24(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(145)) != K(46)) {
+		return nls_aot_apply(K(147), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t3, K(20), frame);
+	return nls_aot_enter(nls_aot_t6, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t25(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(148), out);
+}
+
+static int
+nls_aot_t26(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(149), nls_func_mul)) {
+		int i0, i1;
+
+		i0 = 2;
+		i1 = 3;
+		return nls_aot_int(i0 * i1, out);
+	}
+	return nls_aot_apply(K(152), frame, out);
+}
+
+static int
+nls_aot_t27(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(153), nls_func_set)) {
+		return nls_aot_set(K(154), K(168), frame, out);
+	}
+	return nls_aot_apply(K(171), frame, out);
+}
+
+static int
+nls_aot_t29(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(157), nls_func_add)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(158), frame, &v), v, i0);
+		if (nls_aot_holds(K(159), nls_func_sub)) {
+			int i2, i3;
+
+			i2 = 5;
+			i3 = 4;
+			i1 = i2 - i3;
+		} else {
+			NLS_AOT_INT_OF(nls_aot_apply(K(164), frame, &v), v, i1);
+		}
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(167), frame, out);
+}
+
+static int
+nls_aot_t28(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(172)) != K(168)) {
+		return nls_aot_apply(K(174), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t3, K(20), frame);
+	return nls_aot_enter(nls_aot_t29, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t30(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(175), nls_func_set)) {
+		return nls_aot_set(K(176), K(185), frame, out);
+	}
+	return nls_aot_apply(K(188), frame, out);
+}
+
+static int
+nls_aot_t31(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(189)) != K(168)) {
+		return nls_aot_apply(K(191), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t3, K(20), frame);
+	return nls_aot_enter(nls_aot_t29, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t33(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(179), nls_func_set)) {
+		return nls_aot_set(K(180), K(181), frame, out);
+	}
+	return nls_aot_apply(K(184), frame, out);
+}
+
+static int
+nls_aot_t32(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(192)) != K(185)) {
+		return nls_aot_apply(K(194), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t3, K(20), frame);
+	return nls_aot_enter(nls_aot_t33, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t34(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(195)) != K(168)) {
+		return nls_aot_apply(K(197), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t3, K(20), frame);
+	return nls_aot_enter(nls_aot_t29, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t35(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(198), nls_func_sub)) {
+		int i0, i1;
+
+		i0 = 5;
+		i1 = 4;
+		return nls_aot_int(i0 - i1, out);
+	}
+	return nls_aot_apply(K(201), frame, out);
+}
+
+static int
+nls_aot_t37(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_inst(K(216), frame, out);
+}
+
+static int
+nls_aot_t36(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	nls_aot_thunk_init(&args[0], nls_aot_t3, K(20), frame);
+	return nls_aot_enter(nls_aot_t37, args, 1, frame, out);
+}
+
+static int
+nls_aot_t38(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(235), frame, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	nls_aot_t4,
+	nls_aot_t5,
+	nls_aot_t11,
+	nls_aot_t12,
+	nls_aot_t14,
+	nls_aot_t15,
+	nls_aot_t17,
+	nls_aot_t18,
+	nls_aot_t19,
+	nls_aot_t20,
+	nls_aot_t21,
+	nls_aot_t22,
+	nls_aot_t23,
+	nls_aot_t24,
+	nls_aot_t25,
+	nls_aot_t26,
+	nls_aot_t27,
+	nls_aot_t28,
+	nls_aot_t30,
+	nls_aot_t31,
+	nls_aot_t32,
+	nls_aot_t34,
+	nls_aot_t35,
+	nls_aot_t36,
+	nls_aot_t38,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 236, nls_aot_exprs);
+}
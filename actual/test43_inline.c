@@ -0,0 +1,995 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[280];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 2, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_LIST, 8, -1, NULL},
+	{NLS_TYPE_LIST, 7, 9, NULL},
+	{NLS_TYPE_APPLICATION, 6, 10, NULL},
+	{NLS_TYPE_LIST, 11, -1, NULL},
+	{NLS_TYPE_LIST, 5, 12, NULL},
+	{NLS_TYPE_APPLICATION, 4, 13, NULL},
+	{NLS_TYPE_ABSTRACTION, 3, 14, NULL},
+	{NLS_TYPE_LIST, 15, -1, NULL},
+	{NLS_TYPE_LIST, 1, 16, NULL},
+	{NLS_TYPE_APPLICATION, 0, 17, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "sq"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 21, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_LIST, 25, -1, NULL},
+	{NLS_TYPE_LIST, 24, 26, NULL},
+	{NLS_TYPE_APPLICATION, 23, 27, NULL},
+	{NLS_TYPE_ABSTRACTION, 22, 28, NULL},
+	{NLS_TYPE_LIST, 29, -1, NULL},
+	{NLS_TYPE_LIST, 20, 30, NULL},
+	{NLS_TYPE_APPLICATION, 19, 31, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_VAR, -1, 0, "a"},
+	{NLS_TYPE_LIST, 35, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_VAR, 0, 0, "a"},
+	{NLS_TYPE_LIST, 39, -1, NULL},
+	{NLS_TYPE_APPLICATION, 38, 40, NULL},
+	{NLS_TYPE_VAR, -1, 0, "sq"},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "a"},
+	{NLS_TYPE_INT, 1, 0, NULL},
+	{NLS_TYPE_LIST, 45, -1, NULL},
+	{NLS_TYPE_LIST, 44, 46, NULL},
+	{NLS_TYPE_APPLICATION, 43, 47, NULL},
+	{NLS_TYPE_LIST, 48, -1, NULL},
+	{NLS_TYPE_APPLICATION, 42, 49, NULL},
+	{NLS_TYPE_LIST, 50, -1, NULL},
+	{NLS_TYPE_LIST, 41, 51, NULL},
+	{NLS_TYPE_APPLICATION, 37, 52, NULL},
+	{NLS_TYPE_ABSTRACTION, 36, 53, NULL},
+	{NLS_TYPE_LIST, 54, -1, NULL},
+	{NLS_TYPE_LIST, 34, 55, NULL},
+	{NLS_TYPE_APPLICATION, 33, 56, NULL},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_LIST, 59, -1, NULL},
+	{NLS_TYPE_APPLICATION, 58, 60, NULL},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_LIST, 63, -1, NULL},
+	{NLS_TYPE_APPLICATION, 62, 64, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_LIST, 59, -1, NULL},
+	{NLS_TYPE_APPLICATION, 67, 68, NULL},
+	{NLS_TYPE_VAR, -1, 0, "sq"},
+	{NLS_TYPE_LIST, 63, -1, NULL},
+	{NLS_TYPE_APPLICATION, 70, 71, NULL},
+	{NLS_TYPE_LIST, 72, -1, NULL},
+	{NLS_TYPE_LIST, 69, 73, NULL},
+	{NLS_TYPE_APPLICATION, 66, 74, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_LIST, 59, -1, NULL},
+	{NLS_TYPE_APPLICATION, 78, 79, NULL},
+	{NLS_TYPE_LIST, 80, -1, NULL},
+	{NLS_TYPE_LIST, 77, 81, NULL},
+	{NLS_TYPE_APPLICATION, 76, 82, NULL},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 87, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_LIST, 91, -1, NULL},
+	{NLS_TYPE_LIST, 90, 92, NULL},
+	{NLS_TYPE_APPLICATION, 89, 93, NULL},
+	{NLS_TYPE_ABSTRACTION, 88, 94, NULL},
+	{NLS_TYPE_LIST, 95, -1, NULL},
+	{NLS_TYPE_LIST, 86, 96, NULL},
+	{NLS_TYPE_APPLICATION, 85, 97, NULL},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_LIST, 59, -1, NULL},
+	{NLS_TYPE_APPLICATION, 99, 100, NULL},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_LIST, 63, -1, NULL},
+	{NLS_TYPE_APPLICATION, 103, 104, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "g"},
+	{NLS_TYPE_VAR, -1, 0, "a"},
+	{NLS_TYPE_LIST, 108, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "b"},
+	{NLS_TYPE_LIST, 110, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_VAR, 1, 0, "a"},
+	{NLS_TYPE_LIST, 114, -1, NULL},
+	{NLS_TYPE_APPLICATION, 113, 115, NULL},
+	{NLS_TYPE_VAR, 0, 0, "b"},
+	{NLS_TYPE_LIST, 117, -1, NULL},
+	{NLS_TYPE_LIST, 116, 118, NULL},
+	{NLS_TYPE_APPLICATION, 112, 119, NULL},
+	{NLS_TYPE_ABSTRACTION, 111, 120, NULL},
+	{NLS_TYPE_ABSTRACTION, 109, 121, NULL},
+	{NLS_TYPE_LIST, 122, -1, NULL},
+	{NLS_TYPE_LIST, 107, 123, NULL},
+	{NLS_TYPE_APPLICATION, 106, 124, NULL},
+	{NLS_TYPE_VAR, -1, 0, "g"},
+	{NLS_TYPE_LIST, 63, -1, NULL},
+	{NLS_TYPE_APPLICATION, 126, 127, NULL},
+	{NLS_TYPE_LIST, 45, -1, NULL},
+	{NLS_TYPE_APPLICATION, 128, 129, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "sq"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 133, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "sub"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_LIST, 45, -1, NULL},
+	{NLS_TYPE_LIST, 136, 137, NULL},
+	{NLS_TYPE_APPLICATION, 135, 138, NULL},
+	{NLS_TYPE_ABSTRACTION, 134, 139, NULL},
+	{NLS_TYPE_LIST, 140, -1, NULL},
+	{NLS_TYPE_LIST, 132, 141, NULL},
+	{NLS_TYPE_APPLICATION, 131, 142, NULL},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_LIST, 59, -1, NULL},
+	{NLS_TYPE_APPLICATION, 144, 145, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "rd"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 149, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_VAR, -1, 0, "sq"},
+	{NLS_TYPE_LIST, 153, -1, NULL},
+	{NLS_TYPE_LIST, 152, 154, NULL},
+	{NLS_TYPE_APPLICATION, 151, 155, NULL},
+	{NLS_TYPE_ABSTRACTION, 150, 156, NULL},
+	{NLS_TYPE_LIST, 157, -1, NULL},
+	{NLS_TYPE_LIST, 148, 158, NULL},
+	{NLS_TYPE_APPLICATION, 147, 159, NULL},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_LIST, 59, -1, NULL},
+	{NLS_TYPE_APPLICATION, 161, 162, NULL},
+	{NLS_TYPE_VAR, -1, 0, "rd"},
+	{NLS_TYPE_LIST, 45, -1, NULL},
+	{NLS_TYPE_APPLICATION, 164, 165, NULL},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_LIST, 59, -1, NULL},
+	{NLS_TYPE_APPLICATION, 167, 168, NULL},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_INT, 5, 0, NULL},
+	{NLS_TYPE_LIST, 171, -1, NULL},
+	{NLS_TYPE_APPLICATION, 170, 172, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "big"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 176, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_LIST, 194, -1, NULL},
+	{NLS_TYPE_LIST, 193, 195, NULL},
+	{NLS_TYPE_APPLICATION, 192, 196, NULL},
+	{NLS_TYPE_LIST, 197, -1, NULL},
+	{NLS_TYPE_LIST, 191, 198, NULL},
+	{NLS_TYPE_APPLICATION, 190, 199, NULL},
+	{NLS_TYPE_LIST, 200, -1, NULL},
+	{NLS_TYPE_LIST, 189, 201, NULL},
+	{NLS_TYPE_APPLICATION, 188, 202, NULL},
+	{NLS_TYPE_LIST, 203, -1, NULL},
+	{NLS_TYPE_LIST, 187, 204, NULL},
+	{NLS_TYPE_APPLICATION, 186, 205, NULL},
+	{NLS_TYPE_LIST, 206, -1, NULL},
+	{NLS_TYPE_LIST, 185, 207, NULL},
+	{NLS_TYPE_APPLICATION, 184, 208, NULL},
+	{NLS_TYPE_LIST, 209, -1, NULL},
+	{NLS_TYPE_LIST, 183, 210, NULL},
+	{NLS_TYPE_APPLICATION, 182, 211, NULL},
+	{NLS_TYPE_LIST, 212, -1, NULL},
+	{NLS_TYPE_LIST, 181, 213, NULL},
+	{NLS_TYPE_APPLICATION, 180, 214, NULL},
+	{NLS_TYPE_LIST, 215, -1, NULL},
+	{NLS_TYPE_LIST, 179, 216, NULL},
+	{NLS_TYPE_APPLICATION, 178, 217, NULL},
+	{NLS_TYPE_ABSTRACTION, 177, 218, NULL},
+	{NLS_TYPE_LIST, 219, -1, NULL},
+	{NLS_TYPE_LIST, 175, 220, NULL},
+	{NLS_TYPE_APPLICATION, 174, 221, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "ub"},
+	{NLS_TYPE_VAR, -1, 0, "a"},
+	{NLS_TYPE_LIST, 225, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "big"},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_VAR, 0, 0, "a"},
+	{NLS_TYPE_LIST, 229, -1, NULL},
+	{NLS_TYPE_APPLICATION, 228, 230, NULL},
+	{NLS_TYPE_LIST, 231, -1, NULL},
+	{NLS_TYPE_APPLICATION, 227, 232, NULL},
+	{NLS_TYPE_ABSTRACTION, 226, 233, NULL},
+	{NLS_TYPE_LIST, 234, -1, NULL},
+	{NLS_TYPE_LIST, 224, 235, NULL},
+	{NLS_TYPE_APPLICATION, 223, 236, NULL},
+	{NLS_TYPE_VAR, -1, 0, "ub"},
+	{NLS_TYPE_LIST, 45, -1, NULL},
+	{NLS_TYPE_APPLICATION, 238, 239, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "loop"},
+	{NLS_TYPE_VAR, -1, 0, "n"},
+	{NLS_TYPE_LIST, 243, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "loop"},
+	{NLS_TYPE_VAR, 0, 0, "n"},
+	{NLS_TYPE_LIST, 246, -1, NULL},
+	{NLS_TYPE_APPLICATION, 245, 247, NULL},
+	{NLS_TYPE_ABSTRACTION, 244, 248, NULL},
+	{NLS_TYPE_LIST, 249, -1, NULL},
+	{NLS_TYPE_LIST, 242, 250, NULL},
+	{NLS_TYPE_APPLICATION, 241, 251, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "twice"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 255, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_LIST, 259, -1, NULL},
+	{NLS_TYPE_APPLICATION, 258, 260, NULL},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_VAR, -1, 0, "cube"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_LIST, 264, -1, NULL},
+	{NLS_TYPE_APPLICATION, 263, 265, NULL},
+	{NLS_TYPE_LIST, 266, -1, NULL},
+	{NLS_TYPE_APPLICATION, 262, 267, NULL},
+	{NLS_TYPE_LIST, 268, -1, NULL},
+	{NLS_TYPE_LIST, 261, 269, NULL},
+	{NLS_TYPE_APPLICATION, 257, 270, NULL},
+	{NLS_TYPE_ABSTRACTION, 256, 271, NULL},
+	{NLS_TYPE_LIST, 272, -1, NULL},
+	{NLS_TYPE_LIST, 254, 273, NULL},
+	{NLS_TYPE_APPLICATION, 253, 274, NULL},
+	{NLS_TYPE_VAR, -1, 0, "twice"},
+	{NLS_TYPE_LIST, 59, -1, NULL},
+	{NLS_TYPE_APPLICATION, 276, 277, NULL},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t6(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t7(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t5(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t9(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t10(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t8(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t4(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t11(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t3(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t13(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t12(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t15(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t16(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t14(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t17(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t18(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t19(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t20(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t21(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t23(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t22(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t24(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t25(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t26(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t27(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t28(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t29(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t31(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t32(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t30(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t33(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t35(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t34(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t36(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t37(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t40(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t42(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t41(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t39(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t38(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t43(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t44(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t48(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t47(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t51(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t50(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t49(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t46(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t45(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(0), nls_func_set)) {
+		return nls_aot_set(K(1), K(15), frame, out);
+	}
+	return nls_aot_apply(K(18), frame, out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(19), nls_func_set)) {
+		return nls_aot_set(K(20), K(29), frame, out);
+	}
+	return nls_aot_apply(K(32), frame, out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(33), nls_func_set)) {
+		return nls_aot_set(K(34), K(54), frame, out);
+	}
+	return nls_aot_apply(K(57), frame, out);
+}
+
+static int
+nls_aot_t6(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(4), nls_func_mul)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(5), frame, &v), v, i0);
+		if (nls_aot_holds(K(6), nls_func_mul)) {
+			int i2, i3;
+
+			NLS_AOT_INT_OF(nls_aot_arg(K(7), frame, &v), v, i2);
+			NLS_AOT_INT_OF(nls_aot_arg(K(8), frame, &v), v, i3);
+			i1 = i2 * i3;
+		} else {
+			NLS_AOT_INT_OF(nls_aot_apply(K(11), frame, &v), v, i1);
+		}
+		return nls_aot_int(i0 * i1, out);
+	}
+	return nls_aot_apply(K(14), frame, out);
+}
+
+static int
+nls_aot_t7(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_arg(K(39), frame, out);
+}
+
+static int
+nls_aot_t5(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(38)) != K(15)) {
+		return nls_aot_apply(K(41), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t7, K(39), frame);
+	return nls_aot_enter(nls_aot_t6, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t9(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(23), nls_func_mul)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(24), frame, &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_arg(K(25), frame, &v), v, i1);
+		return nls_aot_int(i0 * i1, out);
+	}
+	return nls_aot_apply(K(28), frame, out);
+}
+
+static int
+nls_aot_t10(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(43), nls_func_add)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(44), frame, &v), v, i0);
+		i1 = 1;
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(48), frame, out);
+}
+
+static int
+nls_aot_t8(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(42)) != K(29)) {
+		return nls_aot_apply(K(50), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t10, K(48), frame);
+	return nls_aot_enter(nls_aot_t9, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t4(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(37), nls_func_add)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_t5(frame, &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_t8(frame, &v), v, i1);
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(53), frame, out);
+}
+
+static int
+nls_aot_t11(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(59), out);
+}
+
+static int
+nls_aot_t3(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(58)) != K(54)) {
+		return nls_aot_apply(K(61), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t11, K(59), frame);
+	return nls_aot_enter(nls_aot_t4, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t13(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(63), out);
+}
+
+static int
+nls_aot_t12(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(62)) != K(15)) {
+		return nls_aot_apply(K(65), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t13, K(63), frame);
+	return nls_aot_enter(nls_aot_t6, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t15(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(67)) != K(15)) {
+		return nls_aot_apply(K(69), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t11, K(59), frame);
+	return nls_aot_enter(nls_aot_t6, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t16(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(70)) != K(29)) {
+		return nls_aot_apply(K(72), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t13, K(63), frame);
+	return nls_aot_enter(nls_aot_t9, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t14(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(66), nls_func_add)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_t15(frame, &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_t16(frame, &v), v, i1);
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(75), frame, out);
+}
+
+static int
+nls_aot_t17(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(76), nls_func_set)) {
+		return nls_aot_set(K(77), K(80), frame, out);
+	}
+	return nls_aot_apply(K(83), frame, out);
+}
+
+static int
+nls_aot_t18(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(84), out);
+}
+
+static int
+nls_aot_t19(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(85), nls_func_set)) {
+		return nls_aot_set(K(86), K(95), frame, out);
+	}
+	return nls_aot_apply(K(98), frame, out);
+}
+
+static int
+nls_aot_t20(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(99)) != K(54)) {
+		return nls_aot_apply(K(101), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t11, K(59), frame);
+	return nls_aot_enter(nls_aot_t4, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t21(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(102), out);
+}
+
+static int
+nls_aot_t23(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(89), nls_func_add)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(90), frame, &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_arg(K(91), frame, &v), v, i1);
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(94), frame, out);
+}
+
+static int
+nls_aot_t22(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(103)) != K(95)) {
+		return nls_aot_apply(K(105), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t13, K(63), frame);
+	return nls_aot_enter(nls_aot_t23, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t24(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(106), nls_func_set)) {
+		return nls_aot_set(K(107), K(122), frame, out);
+	}
+	return nls_aot_apply(K(125), frame, out);
+}
+
+static int
+nls_aot_t25(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(130), frame, out);
+}
+
+static int
+nls_aot_t26(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(131), nls_func_set)) {
+		return nls_aot_set(K(132), K(140), frame, out);
+	}
+	return nls_aot_apply(K(143), frame, out);
+}
+
+static int
+nls_aot_t27(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(144)) != K(54)) {
+		return nls_aot_apply(K(146), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t11, K(59), frame);
+	return nls_aot_enter(nls_aot_t4, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t28(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(147), nls_func_set)) {
+		return nls_aot_set(K(148), K(157), frame, out);
+	}
+	return nls_aot_apply(K(160), frame, out);
+}
+
+static int
+nls_aot_t29(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(161)) != K(54)) {
+		return nls_aot_apply(K(163), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t11, K(59), frame);
+	return nls_aot_enter(nls_aot_t4, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t31(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(151), nls_func_set)) {
+		return nls_aot_set(K(152), K(153), frame, out);
+	}
+	return nls_aot_apply(K(156), frame, out);
+}
+
+static int
+nls_aot_t32(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(45), out);
+}
+
+static int
+nls_aot_t30(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(164)) != K(157)) {
+		return nls_aot_apply(K(166), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t32, K(45), frame);
+	return nls_aot_enter(nls_aot_t31, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t33(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(167)) != K(54)) {
+		return nls_aot_apply(K(169), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t11, K(59), frame);
+	return nls_aot_enter(nls_aot_t4, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t35(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(171), out);
+}
+
+static int
+nls_aot_t34(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(170)) != K(95)) {
+		return nls_aot_apply(K(173), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t35, K(171), frame);
+	return nls_aot_enter(nls_aot_t23, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t36(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(174), nls_func_set)) {
+		return nls_aot_set(K(175), K(219), frame, out);
+	}
+	return nls_aot_apply(K(222), frame, out);
+}
+
+static int
+nls_aot_t37(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(223), nls_func_set)) {
+		return nls_aot_set(K(224), K(234), frame, out);
+	}
+	return nls_aot_apply(K(237), frame, out);
+}
+
+static int
+nls_aot_t40(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(178), nls_func_add)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(179), frame, &v), v, i0);
+		if (nls_aot_holds(K(180), nls_func_add)) {
+			int i2, i3;
+
+			NLS_AOT_INT_OF(nls_aot_arg(K(181), frame, &v), v, i2);
+			if (nls_aot_holds(K(182), nls_func_add)) {
+				int i4, i5;
+
+				NLS_AOT_INT_OF(nls_aot_arg(K(183), frame, &v), v, i4);
+				if (nls_aot_holds(K(184), nls_func_add)) {
+					int i6, i7;
+
+					NLS_AOT_INT_OF(nls_aot_arg(K(185), frame, &v), v, i6);
+					if (nls_aot_holds(K(186), nls_func_add)) {
+						int i8, i9;
+
+						NLS_AOT_INT_OF(nls_aot_arg(K(187), frame, &v), v, i8);
+						if (nls_aot_holds(K(188), nls_func_add)) {
+							int i10, i11;
+
+							NLS_AOT_INT_OF(nls_aot_arg(K(189), frame, &v), v, i10);
+							if (nls_aot_holds(K(190), nls_func_add)) {
+								int i12, i13;
+
+								NLS_AOT_INT_OF(nls_aot_arg(K(191), frame, &v), v, i12);
+								if (nls_aot_holds(K(192), nls_func_add)) {
+									int i14, i15;
+
+									NLS_AOT_INT_OF(nls_aot_arg(K(193), frame, &v), v, i14);
+									NLS_AOT_INT_OF(nls_aot_arg(K(194), frame, &v), v, i15);
+									i13 = i14 + i15;
+								} else {
+									NLS_AOT_INT_OF(nls_aot_apply(K(197), frame, &v), v, i13);
+								}
+								i11 = i12 + i13;
+							} else {
+								NLS_AOT_INT_OF(nls_aot_apply(K(200), frame, &v), v, i11);
+							}
+							i9 = i10 + i11;
+						} else {
+							NLS_AOT_INT_OF(nls_aot_apply(K(203), frame, &v), v, i9);
+						}
+						i7 = i8 + i9;
+					} else {
+						NLS_AOT_INT_OF(nls_aot_apply(K(206), frame, &v), v, i7);
+					}
+					i5 = i6 + i7;
+				} else {
+					NLS_AOT_INT_OF(nls_aot_apply(K(209), frame, &v), v, i5);
+				}
+				i3 = i4 + i5;
+			} else {
+				NLS_AOT_INT_OF(nls_aot_apply(K(212), frame, &v), v, i3);
+			}
+			i1 = i2 + i3;
+		} else {
+			NLS_AOT_INT_OF(nls_aot_apply(K(215), frame, &v), v, i1);
+		}
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(218), frame, out);
+}
+
+static int
+nls_aot_t42(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_arg(K(229), frame, out);
+}
+
+static int
+nls_aot_t41(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(228)) != K(95)) {
+		return nls_aot_apply(K(231), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t42, K(229), frame);
+	return nls_aot_enter(nls_aot_t23, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t39(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(227)) != K(219)) {
+		return nls_aot_apply(K(233), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t41, K(231), frame);
+	return nls_aot_enter(nls_aot_t40, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t38(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(238)) != K(234)) {
+		return nls_aot_apply(K(240), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t32, K(45), frame);
+	return nls_aot_enter(nls_aot_t39, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t43(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(241), nls_func_set)) {
+		return nls_aot_set(K(242), K(249), frame, out);
+	}
+	return nls_aot_apply(K(252), frame, out);
+}
+
+static int
+nls_aot_t44(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(253), nls_func_set)) {
+		return nls_aot_set(K(254), K(272), frame, out);
+	}
+	return nls_aot_apply(K(275), frame, out);
+}
+
+static int
+nls_aot_t48(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_arg(K(259), frame, out);
+}
+
+static int
+nls_aot_t47(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(258)) != K(95)) {
+		return nls_aot_apply(K(261), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t48, K(259), frame);
+	return nls_aot_enter(nls_aot_t23, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t51(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_arg(K(264), frame, out);
+}
+
+static int
+nls_aot_t50(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(263)) != K(95)) {
+		return nls_aot_apply(K(266), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t51, K(264), frame);
+	return nls_aot_enter(nls_aot_t23, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t49(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(262)) != K(95)) {
+		return nls_aot_apply(K(268), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t50, K(266), frame);
+	return nls_aot_enter(nls_aot_t23, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t46(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(257), nls_func_add)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_t47(frame, &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_t49(frame, &v), v, i1);
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(271), frame, out);
+}
+
+static int
+nls_aot_t45(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(276)) != K(272)) {
+		return nls_aot_apply(K(278), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t11, K(59), frame);
+	return nls_aot_enter(nls_aot_t46, args, 1, NULL, out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	nls_aot_t2,
+	nls_aot_t3,
+	nls_aot_t12,
+	nls_aot_t14,
+	nls_aot_t17,
+	nls_aot_t18,
+	nls_aot_t19,
+	nls_aot_t20,
+	nls_aot_t21,
+	nls_aot_t22,
+	nls_aot_t24,
+	nls_aot_t25,
+	nls_aot_t26,
+	nls_aot_t27,
+	nls_aot_t28,
+	nls_aot_t29,
+	nls_aot_t30,
+	nls_aot_t33,
+	nls_aot_t34,
+	nls_aot_t36,
+	nls_aot_t37,
+	nls_aot_t38,
+	nls_aot_t43,
+	nls_aot_t44,
+	nls_aot_t45,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 279, nls_aot_exprs);
+}
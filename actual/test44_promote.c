@@ -0,0 +1,103 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[39];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "g"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "y"},
+	{NLS_TYPE_LIST, 3, -1, NULL},
+	{NLS_TYPE_LIST, 2, 4, NULL},
+	{NLS_TYPE_VAR, -1, 0, "a"},
+	{NLS_TYPE_VAR, -1, 0, "b"},
+	{NLS_TYPE_LIST, 7, -1, NULL},
+	{NLS_TYPE_LIST, 6, 8, NULL},
+	{NLS_TYPE_VAR, 0, 0, "a"},
+	{NLS_TYPE_ABSTRACTION, 9, 10, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_LIST, 13, -1, NULL},
+	{NLS_TYPE_APPLICATION, 12, 14, NULL},
+	{NLS_TYPE_VAR, 1, 0, "y"},
+	{NLS_TYPE_LIST, 16, -1, NULL},
+	{NLS_TYPE_LIST, 15, 17, NULL},
+	{NLS_TYPE_APPLICATION, 11, 18, NULL},
+	{NLS_TYPE_ABSTRACTION, 5, 19, NULL},
+	{NLS_TYPE_LIST, 20, -1, NULL},
+	{NLS_TYPE_LIST, 1, 21, NULL},
+	{NLS_TYPE_APPLICATION, 0, 22, NULL},
+	{NLS_TYPE_VAR, -1, 0, "g"},
+	{NLS_TYPE_INT, 1, 0, NULL},
+	{NLS_TYPE_LIST, 25, -1, NULL},
+	{NLS_TYPE_APPLICATION, 24, 26, NULL},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_LIST, 28, -1, NULL},
+	{NLS_TYPE_APPLICATION, 27, 29, NULL},
+	{NLS_TYPE_VAR, -1, 0, "g"},
+	{NLS_TYPE_VAR, -1, 0, "g"},
+	{NLS_TYPE_LIST, 25, -1, NULL},
+	{NLS_TYPE_APPLICATION, 32, 33, NULL},
+	{NLS_TYPE_LIST, 28, -1, NULL},
+	{NLS_TYPE_APPLICATION, 34, 35, NULL},
+	{NLS_TYPE_VAR, -1, 0, "g"},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t3(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t4(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(0), nls_func_set)) {
+		return nls_aot_set(K(1), K(20), frame, out);
+	}
+	return nls_aot_apply(K(23), frame, out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(30), frame, out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(31), out);
+}
+
+static int
+nls_aot_t3(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_apply(K(36), frame, out);
+}
+
+static int
+nls_aot_t4(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(37), out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	nls_aot_t2,
+	nls_aot_t3,
+	nls_aot_t4,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 38, nls_aot_exprs);
+}
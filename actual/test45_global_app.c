@@ -0,0 +1,143 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[36];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_LIST, 4, -1, NULL},
+	{NLS_TYPE_LIST, 3, 5, NULL},
+	{NLS_TYPE_APPLICATION, 2, 6, NULL},
+	{NLS_TYPE_LIST, 7, -1, NULL},
+	{NLS_TYPE_LIST, 1, 8, NULL},
+	{NLS_TYPE_APPLICATION, 0, 9, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_INT, 1, 0, NULL},
+	{NLS_TYPE_LIST, 13, -1, NULL},
+	{NLS_TYPE_LIST, 12, 14, NULL},
+	{NLS_TYPE_APPLICATION, 11, 15, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "g"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 19, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_LIST, 23, -1, NULL},
+	{NLS_TYPE_LIST, 22, 24, NULL},
+	{NLS_TYPE_APPLICATION, 21, 25, NULL},
+	{NLS_TYPE_ABSTRACTION, 20, 26, NULL},
+	{NLS_TYPE_LIST, 27, -1, NULL},
+	{NLS_TYPE_LIST, 18, 28, NULL},
+	{NLS_TYPE_APPLICATION, 17, 29, NULL},
+	{NLS_TYPE_VAR, -1, 0, "g"},
+	{NLS_TYPE_LIST, 3, -1, NULL},
+	{NLS_TYPE_APPLICATION, 31, 32, NULL},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t4(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t5(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t3(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t6(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(0), nls_func_set)) {
+		return nls_aot_set(K(1), K(7), frame, out);
+	}
+	return nls_aot_apply(K(10), frame, out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(11), nls_func_add)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_global(K(12), &v), v, i0);
+		i1 = 1;
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(16), frame, out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(17), nls_func_set)) {
+		return nls_aot_set(K(18), K(27), frame, out);
+	}
+	return nls_aot_apply(K(30), frame, out);
+}
+
+static int
+nls_aot_t4(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(21), nls_func_mul)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(22), frame, &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_global(K(23), &v), v, i1);
+		return nls_aot_int(i0 * i1, out);
+	}
+	return nls_aot_apply(K(26), frame, out);
+}
+
+static int
+nls_aot_t5(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(3), out);
+}
+
+static int
+nls_aot_t3(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(31)) != K(27)) {
+		return nls_aot_apply(K(33), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t5, K(3), frame);
+	return nls_aot_enter(nls_aot_t4, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t6(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(34), out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	nls_aot_t2,
+	nls_aot_t3,
+	nls_aot_t6,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 35, nls_aot_exprs);
+}
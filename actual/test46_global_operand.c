@@ -0,0 +1,193 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[54];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, -1, 0, "sub"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_INT, 5, 0, NULL},
+	{NLS_TYPE_LIST, 6, -1, NULL},
+	{NLS_TYPE_LIST, 5, 7, NULL},
+	{NLS_TYPE_APPLICATION, 4, 8, NULL},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_LIST, 10, -1, NULL},
+	{NLS_TYPE_LIST, 9, 11, NULL},
+	{NLS_TYPE_APPLICATION, 3, 12, NULL},
+	{NLS_TYPE_INT, 7, 0, NULL},
+	{NLS_TYPE_LIST, 14, -1, NULL},
+	{NLS_TYPE_LIST, 13, 15, NULL},
+	{NLS_TYPE_APPLICATION, 2, 16, NULL},
+	{NLS_TYPE_LIST, 17, -1, NULL},
+	{NLS_TYPE_LIST, 1, 18, NULL},
+	{NLS_TYPE_APPLICATION, 0, 19, NULL},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "g"},
+	{NLS_TYPE_VAR, -1, 0, "x"},
+	{NLS_TYPE_LIST, 23, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "sub"},
+	{NLS_TYPE_VAR, 0, 0, "x"},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_LIST, 27, -1, NULL},
+	{NLS_TYPE_LIST, 26, 28, NULL},
+	{NLS_TYPE_APPLICATION, 25, 29, NULL},
+	{NLS_TYPE_ABSTRACTION, 24, 30, NULL},
+	{NLS_TYPE_LIST, 31, -1, NULL},
+	{NLS_TYPE_LIST, 22, 32, NULL},
+	{NLS_TYPE_APPLICATION, 21, 33, NULL},
+	{NLS_TYPE_VAR, -1, 0, "g"},
+	{NLS_TYPE_INT, 1, 0, NULL},
+	{NLS_TYPE_LIST, 36, -1, NULL},
+	{NLS_TYPE_APPLICATION, 35, 37, NULL},
+	{NLS_TYPE_VAR, -1, 0, "g"},
+	{NLS_TYPE_LIST, 36, -1, NULL},
+	{NLS_TYPE_APPLICATION, 39, 40, NULL},
+	{NLS_TYPE_VAR, -1, 0, "sub"},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_LIST, 43, -1, NULL},
+	{NLS_TYPE_LIST, 36, 44, NULL},
+	{NLS_TYPE_APPLICATION, 42, 45, NULL},
+	{NLS_TYPE_VAR, -1, 0, "sub"},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_LIST, 36, -1, NULL},
+	{NLS_TYPE_LIST, 48, 49, NULL},
+	{NLS_TYPE_APPLICATION, 47, 50, NULL},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t3(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t4(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t5(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t6(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t7(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t8(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(0), nls_func_set)) {
+		return nls_aot_set(K(1), K(17), frame, out);
+	}
+	return nls_aot_apply(K(20), frame, out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(21), nls_func_set)) {
+		return nls_aot_set(K(22), K(31), frame, out);
+	}
+	return nls_aot_apply(K(34), frame, out);
+}
+
+static int
+nls_aot_t3(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(25), nls_func_sub)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_arg(K(26), frame, &v), v, i0);
+		NLS_AOT_INT_OF(nls_aot_global(K(27), &v), v, i1);
+		return nls_aot_int(i0 - i1, out);
+	}
+	return nls_aot_apply(K(30), frame, out);
+}
+
+static int
+nls_aot_t4(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_const(K(36), out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(35)) != K(31)) {
+		return nls_aot_apply(K(38), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t4, K(36), frame);
+	return nls_aot_enter(nls_aot_t3, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t5(nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk args[1];
+
+	if (nls_symbol_get(K(39)) != K(31)) {
+		return nls_aot_apply(K(41), frame, out);
+	}
+	nls_aot_thunk_init(&args[0], nls_aot_t4, K(36), frame);
+	return nls_aot_enter(nls_aot_t3, args, 1, NULL, out);
+}
+
+static int
+nls_aot_t6(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(42), nls_func_sub)) {
+		int i0, i1;
+
+		i0 = 1;
+		NLS_AOT_INT_OF(nls_aot_global(K(43), &v), v, i1);
+		return nls_aot_int(i0 - i1, out);
+	}
+	return nls_aot_apply(K(46), frame, out);
+}
+
+static int
+nls_aot_t7(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(47), nls_func_sub)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_global(K(48), &v), v, i0);
+		i1 = 1;
+		return nls_aot_int(i0 - i1, out);
+	}
+	return nls_aot_apply(K(51), frame, out);
+}
+
+static int
+nls_aot_t8(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(52), out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	nls_aot_t2,
+	nls_aot_t5,
+	nls_aot_t6,
+	nls_aot_t7,
+	nls_aot_t8,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 53, nls_aot_exprs);
+}
@@ -0,0 +1,145 @@
+/* Generated by nameless --emit-c. */
+#include "nameless.h"
+#include "nameless/aot.h"
+
+#define K(i) nls_aot_k[i]
+
+static nls_node *nls_aot_k[50];
+
+static const nls_aot_node nls_aot_nodes[] = {
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_VAR, -1, 0, "p"},
+	{NLS_TYPE_LIST, 2, -1, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, 0, 0, "p"},
+	{NLS_TYPE_INT, 1, 0, NULL},
+	{NLS_TYPE_LIST, 6, -1, NULL},
+	{NLS_TYPE_LIST, 5, 7, NULL},
+	{NLS_TYPE_APPLICATION, 4, 8, NULL},
+	{NLS_TYPE_ABSTRACTION, 3, 9, NULL},
+	{NLS_TYPE_INT, 2, 0, NULL},
+	{NLS_TYPE_LIST, 11, -1, NULL},
+	{NLS_TYPE_APPLICATION, 10, 12, NULL},
+	{NLS_TYPE_LIST, 13, -1, NULL},
+	{NLS_TYPE_LIST, 1, 14, NULL},
+	{NLS_TYPE_APPLICATION, 0, 15, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_INT, 5, 0, NULL},
+	{NLS_TYPE_LIST, 19, -1, NULL},
+	{NLS_TYPE_LIST, 18, 20, NULL},
+	{NLS_TYPE_APPLICATION, 17, 21, NULL},
+	{NLS_TYPE_VAR, -1, 0, "k"},
+	{NLS_TYPE_VAR, -1, 0, "set"},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_VAR, -1, 0, "sub"},
+	{NLS_TYPE_VAR, -1, 0, "mul"},
+	{NLS_TYPE_LIST, 19, -1, NULL},
+	{NLS_TYPE_LIST, 11, 29, NULL},
+	{NLS_TYPE_APPLICATION, 28, 30, NULL},
+	{NLS_TYPE_INT, 3, 0, NULL},
+	{NLS_TYPE_LIST, 32, -1, NULL},
+	{NLS_TYPE_LIST, 31, 33, NULL},
+	{NLS_TYPE_APPLICATION, 27, 34, NULL},
+	{NLS_TYPE_INT, 7, 0, NULL},
+	{NLS_TYPE_LIST, 36, -1, NULL},
+	{NLS_TYPE_LIST, 35, 37, NULL},
+	{NLS_TYPE_APPLICATION, 26, 38, NULL},
+	{NLS_TYPE_LIST, 39, -1, NULL},
+	{NLS_TYPE_LIST, 25, 40, NULL},
+	{NLS_TYPE_APPLICATION, 24, 41, NULL},
+	{NLS_TYPE_VAR, -1, 0, "add"},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{NLS_TYPE_LIST, 6, -1, NULL},
+	{NLS_TYPE_LIST, 44, 45, NULL},
+	{NLS_TYPE_APPLICATION, 43, 46, NULL},
+	{NLS_TYPE_VAR, -1, 0, "f"},
+	{0, 0, 0, NULL},
+};
+
+static int nls_aot_t0(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t1(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t2(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t3(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t4(nls_aot_frame *frame, nls_node **out);
+static int nls_aot_t5(nls_aot_frame *frame, nls_node **out);
+
+static int
+nls_aot_t0(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(0), nls_func_set)) {
+		return nls_aot_set(K(1), K(13), frame, out);
+	}
+	return nls_aot_apply(K(16), frame, out);
+}
+
+static int
+nls_aot_t1(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(17), nls_func_add)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_global(K(18), &v), v, i0);
+		i1 = 5;
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(22), frame, out);
+}
+
+static int
+nls_aot_t2(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(23), out);
+}
+
+static int
+nls_aot_t3(nls_aot_frame *frame, nls_node **out)
+{
+	if (nls_aot_holds(K(24), nls_func_set)) {
+		return nls_aot_set(K(25), K(39), frame, out);
+	}
+	return nls_aot_apply(K(42), frame, out);
+}
+
+static int
+nls_aot_t4(nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *v;
+
+	if (nls_aot_holds(K(43), nls_func_add)) {
+		int i0, i1;
+
+		NLS_AOT_INT_OF(nls_aot_global(K(44), &v), v, i0);
+		i1 = 1;
+		return nls_aot_int(i0 + i1, out);
+	}
+	return nls_aot_apply(K(47), frame, out);
+}
+
+static int
+nls_aot_t5(nls_aot_frame *frame, nls_node **out)
+{
+	return nls_aot_global(K(48), out);
+}
+
+static nls_aot_fp nls_aot_exprs[] = {
+	nls_aot_t0,
+	nls_aot_t1,
+	nls_aot_t2,
+	nls_aot_t3,
+	nls_aot_t4,
+	nls_aot_t5,
+	NULL,
+};
+
+int
+main(void)
+{
+	return nls_aot_main(nls_aot_nodes, nls_aot_k, 49, nls_aot_exprs);
+}
@@ -0,0 +1,319 @@
+/*
+ * Nameless - A lambda calculation language.
+ * Copyright (C) 2009 Yoshifumi Shimono <yoshifumi.shimono@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include "nameless.h"
+#include "nameless/node.h"
+#include "nameless/mm.h"
+#include "nameless/aot.h"
+
+#define NLS_MSG_UNBOUND_INDEX  "Unbound variable index"
+#define NLS_MSG_REDUCTION_FAIL "Reduction failure"
+
+/* Nodes of the program, roots of the collector. */
+static nls_node **nls_aot_nodes;
+static int nls_aot_num_nodes;
+
+static nls_node* nls_aot_build(const nls_aot_node *spec, nls_node **nodes);
+static nls_aot_thunk* nls_aot_lookup(nls_node *var, nls_aot_frame *frame, int depth);
+static nls_node* nls_aot_arg_of(nls_node *var, void *frame, int depth, void **arg_frame);
+#ifdef NLS_GC
+static void nls_aot_trace(void);
+#endif /* NLS_GC */
+
+/**
+ * Run a compiled program: build its nodes, then evaluate and print each
+ * top-level expression, as nls_main() does.
+ * @param  spec      How to build each node.
+ * @param  nodes     Nodes of the program, released at the end.
+ * @param  num_nodes Size of spec[] and nodes[].
+ * @param  exprs     Top-level expressions, terminated by NULL.
+ * @return Exit status.
+ */
+int
+nls_aot_main(const nls_aot_node *spec, nls_node **nodes, int num_nodes, nls_aot_fp *exprs)
+{
+	int i, ret;
+	nls_node *out;
+
+	nls_init(stdout, stderr);
+	nls_aot_nodes = nodes;
+	nls_aot_num_nodes = num_nodes;
+#ifdef NLS_GC
+	nls_gc_root_add(nls_aot_trace);
+#endif /* NLS_GC */
+	for (i = 0; i < num_nodes; i++) {
+		if (!(nodes[i] = nls_aot_build(&spec[i], nodes))) {
+			NLS_ERROR(NLS_MSG_ENOMEM);
+			nls_term();
+			return 1;
+		}
+		nodes[i] = nls_grab(nodes[i]);
+	}
+	for (; *exprs; exprs++) {
+		if ((ret = (*exprs)(NULL, &out))) {
+			NLS_ERROR(NLS_MSG_REDUCTION_FAIL ": errno=%d: %s",
+				ret, strerror(ret));
+			break;
+		}
+		nls_node_print(out, nls_sys_out);
+		fprintf(nls_sys_out, "\n");
+		nls_release(out);
+		nls_mem_safepoint();
+	}
+	for (i = 0; i < num_nodes; i++) {
+		nls_release(nodes[i]);
+	}
+	nls_term();
+	return *exprs ? 1 : 0;
+}
+
+/*
+ * Make a node of the program. Its parts come earlier in nodes[].
+ */
+static nls_node*
+nls_aot_build(const nls_aot_node *spec, nls_node **nodes)
+{
+	nls_string *str;
+	nls_node *node;
+
+	switch (spec->nan_type) {
+	case NLS_TYPE_INT:
+		return nls_int_new(spec->nan_a);
+	case NLS_TYPE_VAR:
+		if (!(str = nls_string_intern(spec->nan_name)) ||
+			!(node = nls_var_new(str))) {
+			return NULL;
+		}
+		node->nn_var.nv_index = spec->nan_a;
+		return node;
+	case NLS_TYPE_ABSTRACTION:
+		return nls_abstraction_new_bound(nodes[spec->nan_a],
+			nodes[spec->nan_b]);
+	case NLS_TYPE_APPLICATION:
+		return nls_application_new(nodes[spec->nan_a], nodes[spec->nan_b]);
+	case NLS_TYPE_LIST:
+		if (!(node = nls_list_new(nodes[spec->nan_a]))) {
+			return NULL;
+		}
+		if (0 <= spec->nan_b) {
+			node->nn_list.nl_rest = nls_grab(nodes[spec->nan_b]);
+		}
+		return node;
+	default:
+		NLS_BUG(NLS_MSG_INVALID_NODE_TYPE ": type=%d", spec->nan_type);
+		return NULL;
+	}
+}
+
+/**
+ * Whether a global still holds the builtin of fp.
+ */
+int
+nls_aot_holds(nls_node *var, nls_fp fp)
+{
+	nls_node *value = nls_symbol_get(var);
+
+	return value && NLS_TYPE_FUNCTION == NLS_NODE_TYPE(value) &&
+		fp == value->nn_func.nf_fp;
+}
+
+int
+nls_aot_const(nls_node *node, nls_node **out)
+{
+	*out = nls_grab(node);
+	return 0;
+}
+
+int
+nls_aot_global(nls_node *var, nls_node **out)
+{
+	nls_node *value = nls_symbol_get(var);
+
+	*out = nls_grab(value ? value : var);
+	return 0;
+}
+
+/**
+ * Value of a parameter: its argument run in the frame of the caller.
+ */
+int
+nls_aot_arg(nls_node *var, nls_aot_frame *frame, nls_node **out)
+{
+	nls_aot_thunk *thunk;
+
+	if (!frame) {
+		*out = nls_grab(var); /* Bound, but not applied yet. */
+		return 0;
+	}
+	thunk = nls_aot_lookup(var, frame, 0);
+	return (thunk->nat_fp)(thunk->nat_frame, out);
+}
+
+int
+nls_aot_inst(nls_node *term, nls_aot_frame *frame, nls_node **out)
+{
+	*out = nls_node_inst(term, frame, 0, nls_aot_arg_of);
+	return *out ? 0 : ENOMEM;
+}
+
+int
+nls_aot_int(int val, nls_node **out)
+{
+	if (!(*out = nls_int_new(val))) {
+		return ENOMEM;
+	}
+	*out = nls_grab(*out);
+	return 0;
+}
+
+/**
+ * Take the int out of a value, releasing it. A value that is not an int
+ * is reduced first, as the builtin reduces its arguments: a global may
+ * hold an application. The reduction is in place, so on a copy.
+ */
+int
+nls_aot_int_of(nls_node *value, int *val)
+{
+	int ret = 0;
+	nls_node *copy;
+
+	if (!NLS_ISINT(value)) {
+		copy = nls_node_clone(value);
+		nls_release(value);
+		if (!(value = copy)) {
+			return ENOMEM;
+		}
+		value = nls_grab(value);
+		ret = nls_eval(&value);
+	}
+	if (!ret && !NLS_ISINT(value)) {
+		ret = EINVAL;
+	}
+	if (!ret) {
+		*val = NLS_INT_VAL(value);
+	}
+	nls_release(value);
+	return ret;
+}
+
+int
+nls_aot_set(nls_node *var, nls_node *def, nls_aot_frame *frame, nls_node **out)
+{
+	if (!(*out = nls_node_inst(def, frame, 0, nls_aot_arg_of))) {
+		return ENOMEM;
+	}
+	nls_symbol_set(var, *out);
+	return 0;
+}
+
+/**
+ * Evaluate an application the compiler left as it is, instantiated in
+ * frame, by the environment evaluator.
+ */
+int
+nls_aot_apply(nls_node *app, nls_aot_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *inst;
+
+	if (!(inst = nls_node_inst(app, frame, 0, nls_aot_arg_of))) {
+		return ENOMEM;
+	}
+	if ((ret = nls_env_eval(&inst))) {
+		nls_release(inst);
+		return ret;
+	}
+	*out = inst;
+	return 0;
+}
+
+void
+nls_aot_thunk_init(nls_aot_thunk *thunk, nls_aot_fp fp, nls_node *term, nls_aot_frame *frame)
+{
+	if (frame && NLS_ISVAR(term) && 0 <= term->nn_var.nv_index) {
+		/* Passed on as it is: share the thunk of the caller. */
+		*thunk = *nls_aot_lookup(term, frame, 0);
+		return;
+	}
+	thunk->nat_fp = fp;
+	thunk->nat_term = term;
+	thunk->nat_frame = frame;
+}
+
+/**
+ * Run a compiled body in a new frame of n arguments. up is the frame of
+ * the parameters further out.
+ */
+int
+nls_aot_enter(nls_aot_fp body, nls_aot_thunk *args, int n, nls_aot_frame *up, nls_node **out)
+{
+	nls_aot_frame frame;
+
+	frame.naf_args = args;
+	frame.naf_num_args = n;
+	frame.naf_up = up;
+	return (body)(&frame, out);
+}
+
+static nls_aot_thunk*
+nls_aot_lookup(nls_node *var, nls_aot_frame *frame, int depth)
+{
+	int i = var->nn_var.nv_index - depth;
+
+	for (; frame; frame = frame->naf_up) {
+		if (i < frame->naf_num_args) {
+			return &(frame->naf_args[i]);
+		}
+		i -= frame->naf_num_args;
+	}
+	NLS_BUG(NLS_MSG_UNBOUND_INDEX ": %d", var->nn_var.nv_index);
+	return NULL;
+}
+
+/*
+ * Argument a bound variable refers to, for nls_node_inst().
+ */
+static nls_node*
+nls_aot_arg_of(nls_node *var, void *frame, int depth, void **arg_frame)
+{
+	nls_aot_thunk *thunk = nls_aot_lookup(var, frame, depth);
+
+	if (!thunk) {
+		return NULL;
+	}
+	*arg_frame = thunk->nat_frame;
+	return thunk->nat_term;
+}
+
+#ifdef NLS_GC
+/*
+ * A collection moves the nodes of the program, the code refers to them
+ * through nls_aot_nodes[] only.
+ */
+static void
+nls_aot_trace(void)
+{
+	int i;
+
+	for (i = 0; i < nls_aot_num_nodes; i++) {
+		nls_gc_visit(&nls_aot_nodes[i]);
+	}
+}
+#endif /* NLS_GC */
@@ -0,0 +1,91 @@
+/*
+ * Nameless - A lambda calculation language.
+ * Copyright (C) 2009 Yoshifumi Shimono <yoshifumi.shimono@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "nameless.h"
+#include "nameless/mm.h"
+#include "nameless/hash.h"
+#include "nameless/node.h"
+#include "nameless/string.h"
+
+#define NLS_BENCH_SEARCH_ROUNDS 10
+
+static double
+nls_bench_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Define n symbols in a fresh table, then look each of them up. */
+static void
+nls_bench_run(int n)
+{
+	int i, j;
+	char buf[32];
+	nls_hash hash;
+	nls_node *item;
+	nls_string **names;
+	double start, add, search;
+
+	if (!(names = malloc(n * sizeof(nls_string*)))) {
+		NLS_ERROR(NLS_MSG_ENOMEM);
+		return;
+	}
+	for (i = 0; i < n; i++) {
+		snprintf(buf, sizeof(buf), "sym%d", i);
+		names[i] = nls_string_intern(buf);
+	}
+	item = nls_grab(nls_int_new(0));
+	nls_hash_init(&hash);
+
+	start = nls_bench_now();
+	for (i = 0; i < n; i++) {
+		nls_hash_add(&hash, names[i], item);
+	}
+	add = nls_bench_now() - start;
+
+	start = nls_bench_now();
+	for (j = 0; j < NLS_BENCH_SEARCH_ROUNDS; j++) {
+		for (i = 0; i < n; i++) {
+			if (!nls_hash_search(&hash, names[i])) {
+				NLS_BUG("%s not found", names[i]->ns_buf);
+			}
+		}
+	}
+	search = nls_bench_now() - start;
+
+	fprintf(stdout, "%8d symbols %12.0f adds/sec %12.0f searches/sec\n", n,
+		n / add, (double)n * NLS_BENCH_SEARCH_ROUNDS / search);
+	nls_hash_term(&hash);
+	nls_release(item);
+	free(names);
+}
+
+int
+main(int argc, char *argv[])
+{
+	nls_init(stdout, stderr);
+	nls_bench_run(100000);
+	nls_bench_run(1000000);
+	nls_term();
+	return 0;
+}
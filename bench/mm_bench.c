@@ -0,0 +1,107 @@
+/*
+ * Nameless - A lambda calculation language.
+ * Copyright (C) 2009 Yoshifumi Shimono <yoshifumi.shimono@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <time.h>
+#include "nameless.h"
+#include "nameless/mm.h"
+#include "nameless/node.h"
+#include "nameless/string.h"
+
+#define NLS_BENCH_ROUNDS 200
+#define NLS_BENCH_BATCH  10000
+
+typedef void (*nls_bench_fp)(void);
+
+static nls_node *nls_bench_nodes[NLS_BENCH_BATCH];
+
+static double
+nls_bench_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* One node allocated and released at a time. */
+static void
+nls_bench_churn(void)
+{
+	int i;
+
+	for (i = 0; i < NLS_BENCH_BATCH; i++) {
+		nls_release(nls_grab(nls_int_box(i)));
+	}
+}
+
+/* A batch of nodes kept alive, then released in allocation order. */
+static void
+nls_bench_batch(void)
+{
+	int i;
+
+	for (i = 0; i < NLS_BENCH_BATCH; i++) {
+		nls_bench_nodes[i] = nls_grab(nls_int_box(i));
+	}
+	for (i = 0; i < NLS_BENCH_BATCH; i++) {
+		nls_release(nls_bench_nodes[i]);
+	}
+}
+
+/* Variable nodes: node + nls_string per item. */
+static void
+nls_bench_var(void)
+{
+	int i;
+
+	for (i = 0; i < NLS_BENCH_BATCH; i++) {
+		nls_string *name = nls_string_new("x");
+
+		nls_bench_nodes[i] = nls_grab(nls_var_new(name));
+	}
+	for (i = 0; i < NLS_BENCH_BATCH; i++) {
+		nls_release(nls_bench_nodes[i]);
+	}
+}
+
+static void
+nls_bench_run(const char *name, nls_bench_fp fp, int allocs_per_item)
+{
+	int i;
+	double start, elapsed;
+	double allocs = (double)NLS_BENCH_ROUNDS * NLS_BENCH_BATCH
+		* allocs_per_item;
+
+	start = nls_bench_now();
+	for (i = 0; i < NLS_BENCH_ROUNDS; i++) {
+		(fp)();
+	}
+	elapsed = nls_bench_now() - start;
+	fprintf(stdout, "%-8s %10.0f allocs/sec\n", name, allocs / elapsed);
+}
+
+int
+main(int argc, char *argv[])
+{
+	nls_init(stdout, stderr);
+	nls_bench_run("churn", nls_bench_churn, 1);
+	nls_bench_run("batch", nls_bench_batch, 1);
+	nls_bench_run("var",   nls_bench_var,   2);
+	nls_term();
+	return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * Nameless - A lambda calculation language.
+ * Copyright (C) 2009 Yoshifumi Shimono <yoshifumi.shimono@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "nameless.h"
+
+#define NLS_BENCH_DEPTH  12 /* Each level calls the one below twice */
+#define NLS_BENCH_CALLS  20 /* Top-level calls of the last level */
+
+typedef void (*nls_bench_gen)(FILE*);
+
+static double
+nls_bench_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Arithmetic through global abstractions. */
+static void
+nls_bench_arith(FILE *out)
+{
+	int i;
+
+	fprintf(out, "set(f0 lambda(a b).add(mul(a a) sub(mul(3 b) 7)))\n");
+	for (i = 1; i <= NLS_BENCH_DEPTH; i++) {
+		fprintf(out, "set(f%d lambda(a b).mod(add(f%d(a b) f%d(b a)) 9973))\n",
+			i, i - 1, i - 1);
+	}
+	for (i = 0; i < NLS_BENCH_CALLS; i++) {
+		fprintf(out, "f%d(%d %d)\n", NLS_BENCH_DEPTH, i + 1, i + 2);
+	}
+}
+
+/* Partially applied builtins and abstractions returning abstractions. */
+static void
+nls_bench_higher(FILE *out)
+{
+	int i;
+
+	fprintf(out, "set(adder lambda(x).lambda(y).add(x y))\n");
+	fprintf(out, "set(inc adder(1))\n");
+	fprintf(out, "set(triple mul(3))\n");
+	fprintf(out, "set(g0 lambda(a).inc(triple(a)))\n");
+	for (i = 1; i <= NLS_BENCH_DEPTH; i++) {
+		fprintf(out, "set(g%d lambda(a).mod(add(g%d(a) g%d(a)) 9973))\n",
+			i, i - 1, i - 1);
+	}
+	for (i = 0; i < NLS_BENCH_CALLS; i++) {
+		fprintf(out, "g%d(%d)\n", NLS_BENCH_DEPTH, i + 1);
+	}
+}
+
+static void
+nls_bench_run(const char *name, nls_bench_gen gen)
+{
+	int i;
+	char *buf;
+	size_t size;
+	FILE *src, *in, *null;
+	double start, elapsed[4];
+	static const nls_eval_mode modes[] = {
+		NLS_EVAL_SUBST, NLS_EVAL_ENV, NLS_EVAL_VM, NLS_EVAL_CLOSURE,
+	};
+
+	if (!(src = open_memstream(&buf, &size))) {
+		return;
+	}
+	(gen)(src);
+	fclose(src);
+	if (!(null = fopen("/dev/null", "w"))) {
+		free(buf);
+		return;
+	}
+	for (i = 0; i < 4; i++) {
+		if (!(in = fmemopen(buf, size, "r"))) {
+			break;
+		}
+		nls_sys_config.nc_eval = modes[i];
+		start = nls_bench_now();
+		nls_main(in, null, stderr);
+		elapsed[i] = nls_bench_now() - start;
+		fclose(in);
+	}
+	fprintf(stdout, "%-8s subst %7.3fs env %7.3fs vm %7.3fs closure %7.3fs\n",
+		name, elapsed[0], elapsed[1], elapsed[2], elapsed[3]);
+	fclose(null);
+	free(buf);
+}
+
+int
+main(int argc, char *argv[])
+{
+	nls_bench_run("arith",  nls_bench_arith);
+	nls_bench_run("higher", nls_bench_higher);
+	return 0;
+}
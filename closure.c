@@ -0,0 +1,751 @@
+/*
+ * Nameless - A lambda calculation language.
+ * Copyright (C) 2009 Yoshifumi Shimono <yoshifumi.shimono@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdlib.h>
+#include <errno.h>
+#include "nameless.h"
+#include "nameless/node.h"
+#include "nameless/mm.h"
+#include "nameless/function.h"
+
+#define NLS_MSG_UNBOUND_INDEX "Unbound variable index"
+
+#define NLS_CLOSURE_FRAME_ARGS 8 /* Most arguments of a compiled call */
+#define NLS_CLOSURE_TABLE_INIT_SIZE 64
+
+/*
+ * Closure compiler. A term compiles to a tree of closures: a C function
+ * specialized for the shape of the term, with its operands resolved at
+ * compile time, such as "mul of a parameter and a constant". Running a
+ * tree is a chain of direct calls, with no dispatch on node types or
+ * counting of arguments.
+ *
+ * The body of an abstraction is compiled on its first call and kept
+ * for the life of the node, which records it by index in nab_code. As
+ * in the VM, arguments are thunks, and what the compiler does not handle
+ * falls back to nls_env_eval().
+ */
+
+struct _nls_closure;
+struct _nls_closure_frame;
+
+typedef int (*nls_closure_fp)(struct _nls_closure*, struct _nls_closure_frame*, nls_node**);
+
+typedef struct _nls_closure {
+	nls_closure_fp ncl_fp;
+	nls_node *ncl_term;    /* Compiled from */
+	nls_node *ncl_func;    /* Global applied, if any */
+	nls_node *ncl_builtin; /* Builtin inlined, while ncl_func holds it */
+	int ncl_int;           /* Constant operand */
+	int ncl_num_args;
+	int ncl_num_subs;      /* The arguments, then a literal body */
+	struct _nls_closure *ncl_subs[];
+} nls_closure;
+
+/* A parameter: the closure of an argument and the frame to run it in. */
+typedef struct _nls_closure_thunk {
+	nls_closure *nct_code;
+	struct _nls_closure_frame *nct_frame;
+} nls_closure_thunk;
+
+typedef struct _nls_closure_frame {
+	nls_closure_thunk *ncf_args;
+	int ncf_num_args;
+	struct _nls_closure_frame *ncf_up;
+} nls_closure_frame;
+
+/* Compiled bodies; an abstraction holds the index of its own, plus one. */
+typedef struct _nls_closure_entry {
+	nls_node *nce_owner; /* NULL if free */
+	nls_closure *nce_code;
+	int nce_next_free;
+} nls_closure_entry;
+
+static nls_closure_entry *nls_closure_table;
+static int nls_closure_num;
+static int nls_closure_size;
+static int nls_closure_free_list = -1;
+
+#define NLS_CLOSURE_RUN(cl, frame, out) ((cl)->ncl_fp((cl), (frame), (out)))
+#define NLS_CLOSURE_REDEFINED(cl) ((cl)->ncl_func && \
+	nls_symbol_get((cl)->ncl_func) != (cl)->ncl_builtin)
+
+static int nls_closure_const(nls_closure *cl, nls_closure_frame *frame, nls_node **out);
+static int nls_closure_global(nls_closure *cl, nls_closure_frame *frame, nls_node **out);
+static int nls_closure_arg(nls_closure *cl, nls_closure_frame *frame, nls_node **out);
+static int nls_closure_inst(nls_closure *cl, nls_closure_frame *frame, nls_node **out);
+static int nls_closure_set(nls_closure *cl, nls_closure_frame *frame, nls_node **out);
+static int nls_closure_call(nls_closure *cl, nls_closure_frame *frame, nls_node **out);
+static int nls_closure_enter(nls_closure *cl, nls_closure_frame *frame, nls_node **out);
+static int nls_closure_apply(nls_closure *cl, nls_closure_frame *frame, nls_node **out);
+static int nls_closure_run_body(nls_closure *body, nls_closure *cl, nls_closure_frame *frame, nls_closure_frame *up, nls_node **out);
+static int nls_closure_strict_call(nls_node *func, nls_closure *cl, nls_closure_frame *frame, nls_node **out);
+static int nls_closure_fallback(nls_node *func, nls_node *args, nls_closure_frame *frame, nls_node **out);
+static int nls_closure_operands(nls_node *lhs, nls_node *rhs, int *a, int *b);
+static int nls_closure_int_of(nls_node *value, int *val);
+static nls_closure_thunk* nls_closure_lookup(nls_node *var, nls_closure_frame *frame, int depth);
+static nls_node* nls_closure_arg_of(nls_node *var, void *frame, int depth, void **arg_frame);
+static nls_closure* nls_closure_of(nls_node *abst);
+static void nls_closure_table_clear(void);
+static nls_closure* nls_closure_new(nls_closure_fp fp, nls_node *term, int num_subs);
+static void nls_closure_free(nls_closure *cl);
+static nls_closure* nls_closure_compile(nls_node *term);
+static nls_closure* nls_closure_compile_app(nls_node *term);
+static nls_closure_fp nls_closure_builtin_fp(nls_node *func, nls_closure *cl);
+
+/**
+ * [DESTRUCTIVE] Evaluate an expression as nls_env_eval() does, by
+ * compiling it to closures first.
+ * @param  tree Target syntax tree.
+ * @retval 0    Evaluation succeed.
+ * @retval else Error code.
+ */
+int
+nls_closure_eval(nls_node **tree)
+{
+	int ret;
+	nls_node *out;
+	nls_closure *cl;
+
+	if (!(cl = nls_closure_compile(*tree))) {
+		return ENOMEM;
+	}
+	ret = NLS_CLOSURE_RUN(cl, NULL, &out);
+	nls_closure_free(cl);
+	if (ret) {
+		return ret;
+	}
+	nls_release(*tree);
+	*tree = out;
+	return 0;
+}
+
+/**
+ * Drop the compiled body of an abstraction being released.
+ */
+void
+nls_closure_forget(nls_node *abst)
+{
+	nls_closure_entry *ent;
+	int i = abst->nn_abst.nab_code - 1;
+
+	if (i < 0 || i >= nls_closure_num) {
+		return;
+	}
+	if ((ent = &nls_closure_table[i])->nce_owner != abst) {
+		return;
+	}
+	nls_closure_free(ent->nce_code);
+	ent->nce_owner = NULL;
+	ent->nce_code = NULL;
+	ent->nce_next_free = nls_closure_free_list;
+	nls_closure_free_list = i;
+}
+
+/**
+ * Called at safe points, where the collector may run.
+ */
+void
+nls_closure_safepoint(void)
+{
+#ifdef NLS_GC
+	/* A collection moves the nodes the closures refer to. */
+	nls_closure_table_clear();
+#endif /* NLS_GC */
+}
+
+void
+nls_closure_term(void)
+{
+	nls_closure_table_clear();
+	free(nls_closure_table);
+	nls_closure_table = NULL;
+	nls_closure_size = 0;
+}
+
+static int
+nls_closure_const(nls_closure *cl, nls_closure_frame *frame, nls_node **out)
+{
+	*out = nls_grab(cl->ncl_term);
+	return 0;
+}
+
+static int
+nls_closure_global(nls_closure *cl, nls_closure_frame *frame, nls_node **out)
+{
+	nls_node *value = nls_symbol_get(cl->ncl_term);
+
+	*out = nls_grab(value ? value : cl->ncl_term);
+	return 0;
+}
+
+static int
+nls_closure_arg(nls_closure *cl, nls_closure_frame *frame, nls_node **out)
+{
+	nls_closure_thunk *thunk;
+
+	if (!frame) {
+		*out = nls_grab(cl->ncl_term); /* Bound, but not applied yet. */
+		return 0;
+	}
+	if (!(thunk = nls_closure_lookup(cl->ncl_term, frame, 0))) {
+		return EINVAL;
+	}
+	return NLS_CLOSURE_RUN(thunk->nct_code, thunk->nct_frame, out);
+}
+
+static int
+nls_closure_inst(nls_closure *cl, nls_closure_frame *frame, nls_node **out)
+{
+	*out = nls_node_inst(cl->ncl_term, frame, 0, nls_closure_arg_of);
+	return *out ? 0 : ENOMEM;
+}
+
+#define NLS_CLOSURE_DEF_ARITH(name, op) \
+	static int \
+	nls_closure_##name(nls_closure *cl, nls_closure_frame *frame, nls_node **out) \
+	{ \
+		int a, b, ret; \
+		nls_node *lhs, *rhs; \
+\
+		if (NLS_CLOSURE_REDEFINED(cl)) { \
+			return nls_closure_call(cl, frame, out); \
+		} \
+		if ((ret = NLS_CLOSURE_RUN(cl->ncl_subs[0], frame, &lhs))) { \
+			return ret; \
+		} \
+		if ((ret = NLS_CLOSURE_RUN(cl->ncl_subs[1], frame, &rhs))) { \
+			nls_release(lhs); \
+			return ret; \
+		} \
+		if ((ret = nls_closure_operands(lhs, rhs, &a, &b))) { \
+			return ret; \
+		} \
+		*out = nls_int_new(a op b); \
+		return *out ? (*out = nls_grab(*out), 0) : ENOMEM; \
+	} \
+\
+	/* The same, with a constant int on the right. */ \
+	static int \
+	nls_closure_##name##_int(nls_closure *cl, nls_closure_frame *frame, nls_node **out) \
+	{ \
+		int a, ret; \
+		nls_node *lhs; \
+\
+		if (NLS_CLOSURE_REDEFINED(cl)) { \
+			return nls_closure_call(cl, frame, out); \
+		} \
+		if ((ret = NLS_CLOSURE_RUN(cl->ncl_subs[0], frame, &lhs))) { \
+			return ret; \
+		} \
+		if ((ret = nls_closure_int_of(lhs, &a))) { \
+			return ret; \
+		} \
+		*out = nls_int_new(a op cl->ncl_int); \
+		return *out ? (*out = nls_grab(*out), 0) : ENOMEM; \
+	}
+
+NLS_CLOSURE_DEF_ARITH(add, +)
+NLS_CLOSURE_DEF_ARITH(sub, -)
+NLS_CLOSURE_DEF_ARITH(mul, *)
+NLS_CLOSURE_DEF_ARITH(div, /)
+NLS_CLOSURE_DEF_ARITH(mod, %)
+
+static int
+nls_closure_set(nls_closure *cl, nls_closure_frame *frame, nls_node **out)
+{
+	if (NLS_CLOSURE_REDEFINED(cl)) {
+		return nls_closure_call(cl, frame, out);
+	}
+	if (!(*out = nls_node_inst(cl->ncl_subs[1]->ncl_term, frame, 0,
+		nls_closure_arg_of))) {
+		return ENOMEM;
+	}
+	nls_symbol_set(cl->ncl_subs[0]->ncl_term, *out);
+	return 0;
+}
+
+/*
+ * Apply a global, or a builtin, to the arguments.
+ */
+static int
+nls_closure_call(nls_closure *cl, nls_closure_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_closure *body;
+	nls_node *value = cl->ncl_builtin;
+	nls_node *func = cl->ncl_func;
+
+	if (func && !(value = nls_symbol_get(func))) {
+		NLS_ERROR(NLS_MSG_NO_SUCH_SYMBOL ": %s",
+			func->nn_var.nv_name->ns_buf);
+		return EINVAL;
+	}
+	switch (NLS_NODE_TYPE(value)) {
+	case NLS_TYPE_FUNCTION:
+		if (value->nn_func.nf_strict &&
+			value->nn_func.nf_num_args == cl->ncl_num_args) {
+			return nls_closure_strict_call(value, cl, frame, out);
+		}
+		break;
+	case NLS_TYPE_ABSTRACTION:
+		if (value->nn_abst.nab_num_args != cl->ncl_num_args) {
+			break;
+		}
+		if (!(body = nls_closure_of(value))) {
+			return ENOMEM;
+		}
+		/* Redefining the global inside must not free the body. */
+		value = nls_grab(value);
+		ret = nls_closure_run_body(body, cl, frame, NULL, out);
+		nls_release(value);
+		return ret;
+	default:
+		break;
+	}
+	return nls_closure_fallback(value,
+		cl->ncl_term->nn_app.nap_args, frame, out);
+}
+
+/*
+ * Apply a literal abstraction, whose body comes after the arguments.
+ */
+static int
+nls_closure_enter(nls_closure *cl, nls_closure_frame *frame, nls_node **out)
+{
+	return nls_closure_run_body(cl->ncl_subs[cl->ncl_num_args], cl,
+		frame, frame, out);
+}
+
+static int
+nls_closure_apply(nls_closure *cl, nls_closure_frame *frame, nls_node **out)
+{
+	nls_node *term = cl->ncl_term;
+
+	return nls_closure_fallback(term->nn_app.nap_func,
+		term->nn_app.nap_args, frame, out);
+}
+
+/*
+ * Run body in a new frame binding the arguments of cl, which run in
+ * frame. up is the frame of the parameters further out.
+ */
+static int
+nls_closure_run_body(nls_closure *body, nls_closure *cl, nls_closure_frame *frame, nls_closure_frame *up, nls_node **out)
+{
+	int i, ret;
+	nls_closure_thunk *thunk;
+	nls_closure_frame callee;
+	nls_closure_thunk thunks[NLS_CLOSURE_FRAME_ARGS];
+
+	for (i = 0; i < cl->ncl_num_args; i++) {
+		nls_closure *arg = cl->ncl_subs[i];
+
+		if (frame && nls_closure_arg == arg->ncl_fp) {
+			/* Passed on as it is: share the thunk of the caller. */
+			if (!(thunk = nls_closure_lookup(arg->ncl_term, frame, 0))) {
+				return EINVAL;
+			}
+			thunks[i] = *thunk;
+			continue;
+		}
+		thunks[i].nct_code = arg;
+		thunks[i].nct_frame = frame;
+	}
+	callee.ncf_args = thunks;
+	callee.ncf_num_args = cl->ncl_num_args;
+	callee.ncf_up = up;
+	if ((ret = nls_eval_enter())) {
+		return ret;
+	}
+	ret = NLS_CLOSURE_RUN(body, &callee, out);
+	nls_eval_leave();
+	return ret;
+}
+
+/*
+ * Call a strict builtin with the values of the arguments of cl, as the
+ * environment evaluator does.
+ */
+static int
+nls_closure_strict_call(nls_node *func, nls_closure *cl, nls_closure_frame *frame, nls_node **out)
+{
+	int i, ret = 0;
+	nls_node *value;
+	nls_node cells[NLS_CLOSURE_FRAME_ARGS];
+
+	for (i = 0; i < cl->ncl_num_args; i++) {
+		if ((ret = NLS_CLOSURE_RUN(cl->ncl_subs[i], frame, &value))) {
+			break;
+		}
+		nls_list_init(&cells[i], value);
+		nls_release(value);
+		if (i) {
+			cells[i-1].nn_list.nl_rest = &cells[i];
+		}
+	}
+	if (!ret) {
+		*out = NULL;
+		if (!(ret = nls_function_call(func, cells, out))) {
+			*out = nls_grab(*out);
+			if (nls_sys_config.nc_intern) {
+				nls_node_intern(out);
+			}
+		}
+	}
+	while (i--) {
+		nls_release(cells[i].nn_list.nl_head);
+	}
+	return ret;
+}
+
+/*
+ * Apply func to args instantiated in frame, by the environment
+ * evaluator.
+ */
+static int
+nls_closure_fallback(nls_node *func, nls_node *args, nls_closure_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *actuals, *app;
+
+	if (!(actuals = nls_node_inst(args, frame, 0, nls_closure_arg_of))) {
+		return ENOMEM;
+	}
+	app = nls_application_new(func, actuals);
+	nls_release(actuals);
+	if (!app) {
+		return ENOMEM;
+	}
+	app = nls_grab(app);
+	if ((ret = nls_env_eval(&app))) {
+		nls_release(app);
+		return ret;
+	}
+	*out = app;
+	return 0;
+}
+
+/*
+ * Take the ints out of two values, releasing them.
+ */
+static int
+nls_closure_operands(nls_node *lhs, nls_node *rhs, int *a, int *b)
+{
+	int ret;
+
+	if ((ret = nls_closure_int_of(lhs, a))) {
+		nls_release(rhs);
+		return ret;
+	}
+	return nls_closure_int_of(rhs, b);
+}
+
+/*
+ * Take the int out of a value, releasing it. A value that is not an int
+ * is reduced first, as the builtin reduces its arguments: a global may
+ * hold an application. Hot globals run under the substitution evaluator,
+ * which reduces in place, so a copy is reduced.
+ */
+static int
+nls_closure_int_of(nls_node *value, int *val)
+{
+	int ret = 0;
+	nls_node *copy;
+
+	if (!NLS_ISINT(value)) {
+		copy = nls_node_clone(value);
+		nls_release(value);
+		if (!(value = copy)) {
+			return ENOMEM;
+		}
+		value = nls_grab(value);
+		ret = nls_eval(&value);
+	}
+	if (!ret && !NLS_ISINT(value)) {
+		ret = EINVAL;
+	}
+	if (!ret) {
+		*val = NLS_INT_VAL(value);
+	}
+	nls_release(value);
+	return ret;
+}
+
+/*
+ * Parameter a bound variable refers to, depth parameters inside frame.
+ */
+static nls_closure_thunk*
+nls_closure_lookup(nls_node *var, nls_closure_frame *frame, int depth)
+{
+	int i = var->nn_var.nv_index - depth;
+
+	for (; frame; frame = frame->ncf_up) {
+		if (i < frame->ncf_num_args) {
+			return &(frame->ncf_args[i]);
+		}
+		i -= frame->ncf_num_args;
+	}
+	NLS_BUG(NLS_MSG_UNBOUND_INDEX ": %d", var->nn_var.nv_index);
+	return NULL;
+}
+
+/*
+ * Argument a bound variable refers to, for nls_node_inst().
+ */
+static nls_node*
+nls_closure_arg_of(nls_node *var, void *frame, int depth, void **arg_frame)
+{
+	nls_closure_thunk *thunk = nls_closure_lookup(var, frame, depth);
+
+	if (!thunk) {
+		return NULL;
+	}
+	*arg_frame = thunk->nct_frame;
+	return thunk->nct_code->ncl_term;
+}
+
+/*
+ * Compiled body of an abstraction, compiled on first use.
+ */
+static nls_closure*
+nls_closure_of(nls_node *abst)
+{
+	int i, size;
+	nls_closure *body;
+	nls_closure_entry *table;
+
+	i = abst->nn_abst.nab_code - 1;
+	if (0 <= i && i < nls_closure_num &&
+		nls_closure_table[i].nce_owner == abst) {
+		return nls_closure_table[i].nce_code;
+	}
+	if (!(body = nls_closure_compile(abst->nn_abst.nab_def))) {
+		return NULL;
+	}
+	if (0 <= (i = nls_closure_free_list)) {
+		nls_closure_free_list = nls_closure_table[i].nce_next_free;
+	} else {
+		if (nls_closure_num == nls_closure_size) {
+			size = nls_closure_size ?
+				2 * nls_closure_size : NLS_CLOSURE_TABLE_INIT_SIZE;
+			if (!(table = realloc(nls_closure_table,
+					size * sizeof(nls_closure_entry)))) {
+				nls_closure_free(body);
+				return NULL;
+			}
+			nls_closure_table = table;
+			nls_closure_size = size;
+		}
+		i = nls_closure_num++;
+	}
+	nls_closure_table[i].nce_owner = abst;
+	nls_closure_table[i].nce_code = body;
+	abst->nn_abst.nab_code = i + 1;
+	return body;
+}
+
+static void
+nls_closure_table_clear(void)
+{
+	int i;
+
+	for (i = 0; i < nls_closure_num; i++) {
+		if (nls_closure_table[i].nce_owner) {
+			nls_closure_free(nls_closure_table[i].nce_code);
+		}
+	}
+	nls_closure_num = 0;
+	nls_closure_free_list = -1;
+}
+
+static nls_closure*
+nls_closure_new(nls_closure_fp fp, nls_node *term, int num_subs)
+{
+	nls_closure *cl;
+
+	cl = malloc(sizeof(nls_closure) + num_subs * sizeof(nls_closure*));
+	if (!cl) {
+		return NULL;
+	}
+	cl->ncl_fp = fp;
+	cl->ncl_term = term;
+	cl->ncl_func = NULL;
+	cl->ncl_builtin = NULL;
+	cl->ncl_int = 0;
+	cl->ncl_num_args = 0;
+	cl->ncl_num_subs = num_subs;
+	return cl;
+}
+
+static void
+nls_closure_free(nls_closure *cl)
+{
+	int i;
+
+	for (i = 0; i < cl->ncl_num_subs; i++) {
+		if (cl->ncl_subs[i]) {
+			nls_closure_free(cl->ncl_subs[i]);
+		}
+	}
+	free(cl);
+}
+
+/*
+ * Compile term. The closures refer to the nodes of term, which must
+ * outlive them.
+ */
+static nls_closure*
+nls_closure_compile(nls_node *term)
+{
+	nls_closure_fp fp = nls_closure_const;
+
+	switch (NLS_NODE_TYPE(term)) {
+	case NLS_TYPE_VAR:
+		if (0 <= term->nn_var.nv_index) {
+			fp = nls_closure_arg;
+			break;
+		}
+		nls_symbol_resolve(term);
+		fp = nls_closure_global;
+		break;
+	case NLS_TYPE_ABSTRACTION:
+	case NLS_TYPE_LIST:
+		if (!nls_node_closed(term, 0)) {
+			fp = nls_closure_inst;
+		}
+		break;
+	case NLS_TYPE_APPLICATION:
+		return nls_closure_compile_app(term);
+	default:
+		break;
+	}
+	return nls_closure_new(fp, term, 0);
+}
+
+static nls_closure*
+nls_closure_compile_app(nls_node *term)
+{
+	int i, n;
+	nls_closure *cl;
+	nls_closure_fp fp;
+	nls_node **item, *tmp;
+	nls_node *func = term->nn_app.nap_func;
+
+	n = nls_list_count(term->nn_app.nap_args);
+	if (NLS_CLOSURE_FRAME_ARGS < n ||
+		(NLS_TYPE_ABSTRACTION == NLS_NODE_TYPE(func) &&
+			func->nn_abst.nab_num_args != n)) {
+		return nls_closure_new(nls_closure_apply, term, 0);
+	}
+	switch (NLS_NODE_TYPE(func)) {
+	case NLS_TYPE_VAR:
+	case NLS_TYPE_FUNCTION:
+		cl = nls_closure_new(nls_closure_call, term, n);
+		break;
+	case NLS_TYPE_ABSTRACTION:
+		cl = nls_closure_new(nls_closure_enter, term, n + 1);
+		break;
+	default:
+		return nls_closure_new(nls_closure_apply, term, 0);
+	}
+	if (!cl) {
+		return NULL;
+	}
+	for (i = 0; i < cl->ncl_num_subs; i++) {
+		cl->ncl_subs[i] = NULL;
+	}
+	cl->ncl_num_args = n;
+	i = 0;
+	nls_list_foreach(term->nn_app.nap_args, &item, &tmp) {
+		if (!(cl->ncl_subs[i++] = nls_closure_compile(*item))) {
+			goto free_exit;
+		}
+	}
+	switch (NLS_NODE_TYPE(func)) {
+	case NLS_TYPE_VAR:
+		nls_symbol_resolve(func);
+		cl->ncl_func = func;
+		cl->ncl_builtin = nls_symbol_get(func);
+		break;
+	case NLS_TYPE_FUNCTION:
+		cl->ncl_builtin = func;
+		break;
+	default:
+		if (!(cl->ncl_subs[n] = nls_closure_compile(func->nn_abst.nab_def))) {
+			goto free_exit;
+		}
+		return cl;
+	}
+	/* Inline the builtin, as long as the global still holds it. */
+	if ((fp = nls_closure_builtin_fp(cl->ncl_builtin, cl))) {
+		cl->ncl_fp = fp;
+	}
+	return cl;
+free_exit:
+	nls_closure_free(cl);
+	return NULL;
+}
+
+/*
+ * Closure function specialized for calling func with the arguments of
+ * cl, or NULL.
+ */
+static nls_closure_fp
+nls_closure_builtin_fp(nls_node *func, nls_closure *cl)
+{
+	int i;
+	nls_fp fp;
+	nls_node *arg;
+	static const struct {
+		nls_fp fp;
+		nls_closure_fp any;
+		nls_closure_fp with_int;
+	} ops[] = {
+		{ nls_func_add, nls_closure_add, nls_closure_add_int },
+		{ nls_func_sub, nls_closure_sub, nls_closure_sub_int },
+		{ nls_func_mul, nls_closure_mul, nls_closure_mul_int },
+		{ nls_func_div, nls_closure_div, nls_closure_div_int },
+		{ nls_func_mod, nls_closure_mod, nls_closure_mod_int },
+	};
+
+	if (!func || NLS_TYPE_FUNCTION != NLS_NODE_TYPE(func) ||
+		2 != cl->ncl_num_args) {
+		return NULL;
+	}
+	fp = func->nn_func.nf_fp;
+	if (nls_func_set == fp) {
+		arg = cl->ncl_subs[0]->ncl_term;
+		if (NLS_ISVAR(arg) && arg->nn_var.nv_index < 0) {
+			return nls_closure_set;
+		}
+		return NULL;
+	}
+	for (i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) {
+		if (ops[i].fp != fp) {
+			continue;
+		}
+		arg = cl->ncl_subs[1]->ncl_term;
+		if (!NLS_ISINT(arg)) {
+			return ops[i].any;
+		}
+		cl->ncl_int = NLS_INT_VAL(arg);
+		return ops[i].with_int;
+	}
+	return NULL;
+}
+
@@ -0,0 +1,631 @@
+/*
+ * Nameless - A lambda calculation language.
+ * Copyright (C) 2009 Yoshifumi Shimono <yoshifumi.shimono@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include "nameless.h"
+#include "nameless/node.h"
+#include "nameless/function.h"
+#include "nameless/aot.h"
+
+#define NLS_EMIT_MAP_INIT_SIZE 256
+
+/*
+ * C code generator (nameless --emit-c). The program becomes a C file
+ * which builds its nodes at start-up and evaluates each top-level
+ * expression by compiled functions, linked against the interpreter
+ * (see aot.c). Each term compiled is a function of a frame of thunks:
+ *
+ *   - Arithmetic builtins are inline C operations, behind a check that
+ *     the global still holds the builtin.
+ *   - A top-level set() of a closed abstraction makes its body a C
+ *     function. Later calls of the name run it directly, as long as the
+ *     global still holds that abstraction.
+ *   - Anything else is instantiated and left to nls_env_eval().
+ */
+
+/* Node to number. */
+typedef struct _nls_emit_map {
+	nls_node **nem_keys;
+	int *nem_values;
+	int nem_num;
+	int nem_size;
+} nls_emit_map;
+
+typedef struct _nls_emitter {
+	FILE *ner_table;  /* Table of the nodes */
+	FILE *ner_protos;
+	FILE *ner_funcs;
+	nls_emit_map ner_nodes;    /* Node to index in K() */
+	nls_emit_map ner_terms;    /* Term to compiled function */
+	nls_node **ner_defs;       /* Abstraction set to each slot */
+	int ner_defs_size;
+	int ner_num_nodes;
+	int ner_num_terms;
+	int ner_failed;
+} nls_emitter;
+
+/* The function being generated. */
+typedef struct _nls_emit_func {
+	FILE *nef_out;
+	int nef_num_ints;
+	int nef_use_v; /* Declares ret and v */
+} nls_emit_func;
+
+static int nls_emit_term(nls_emitter *em, nls_node *term);
+static void nls_emit_body(nls_emitter *em, nls_emit_func *fn, nls_node *term);
+static void nls_emit_int(nls_emitter *em, nls_emit_func *fn, nls_node *term, int dest, int indent);
+static void nls_emit_call(nls_emitter *em, nls_emit_func *fn, nls_node *term, nls_node *guard, int body, const char *up);
+static void nls_emit_line(FILE *out, int indent, const char *fmt, ...);
+static int nls_emit_node(nls_emitter *em, nls_node *node);
+static nls_fp nls_emit_builtin_fp(nls_node *var);
+static const char* nls_emit_builtin_name(nls_node *var);
+static char nls_emit_arith_op(nls_node *app);
+static nls_node* nls_emit_def_of(nls_emitter *em, nls_node *var);
+static void nls_emit_define(nls_emitter *em, nls_node *expr);
+static uintptr_t nls_emit_map_hash(nls_node *key);
+static int nls_emit_map_get(nls_emit_map *map, nls_node *key);
+static int nls_emit_map_put(nls_emit_map *map, nls_node *key, int value);
+static void nls_emit_map_free(nls_emit_map *map);
+
+/**
+ * Write a C program evaluating prog, a list of top-level expressions,
+ * as the environment evaluator would.
+ * @param  prog Program with its globals resolved, or NULL.
+ * @param  out  Stream of the C source.
+ * @retval 0    Success.
+ * @retval else Error code.
+ */
+int
+nls_emit_c(nls_node *prog, FILE *out)
+{
+	int ret = 0;
+	nls_emitter em;
+	nls_node **item, *tmp;
+	FILE *exprs;
+	char *table = NULL, *protos = NULL, *funcs = NULL, *list = NULL;
+	size_t table_size, protos_size, funcs_size, list_size;
+
+	memset(&em, 0, sizeof(em));
+	em.ner_table = open_memstream(&table, &table_size);
+	em.ner_protos = open_memstream(&protos, &protos_size);
+	em.ner_funcs = open_memstream(&funcs, &funcs_size);
+	exprs = open_memstream(&list, &list_size);
+	if (!em.ner_table || !em.ner_protos || !em.ner_funcs || !exprs) {
+		NLS_ERROR(NLS_MSG_ENOMEM);
+		return ENOMEM;
+	}
+	if (prog) {
+		nls_list_foreach(prog, &item, &tmp) {
+			nls_emit_line(exprs, 1, "nls_aot_t%d,",
+				nls_emit_term(&em, *item));
+			nls_emit_define(&em, *item);
+		}
+	}
+	fclose(em.ner_table);
+	fclose(em.ner_protos);
+	fclose(em.ner_funcs);
+	fclose(exprs);
+	if (em.ner_failed) {
+		ret = ENOMEM;
+		goto free_exit;
+	}
+
+	fprintf(out, "/* Generated by nameless --emit-c. */\n");
+	fprintf(out, "#include \"nameless.h\"\n");
+	fprintf(out, "#include \"nameless/aot.h\"\n\n");
+	fprintf(out, "#define K(i) nls_aot_k[i]\n\n");
+	fprintf(out, "static nls_node *nls_aot_k[%d];\n\n", em.ner_num_nodes + 1);
+	fprintf(out, "static const nls_aot_node nls_aot_nodes[] = {\n");
+	fputs(table, out);
+	fprintf(out, "\t{0, 0, 0, NULL},\n};\n\n");
+	fputs(protos, out);
+	fprintf(out, "\n");
+	fputs(funcs, out);
+	fprintf(out, "static nls_aot_fp nls_aot_exprs[] = {\n");
+	fputs(list, out);
+	fprintf(out, "\tNULL,\n};\n\n");
+	fprintf(out, "int\nmain(void)\n{\n");
+	fprintf(out, "\treturn nls_aot_main(nls_aot_nodes, nls_aot_k, %d, nls_aot_exprs);\n",
+		em.ner_num_nodes);
+	fprintf(out, "}\n");
+free_exit:
+	free(table);
+	free(protos);
+	free(funcs);
+	free(list);
+	free(em.ner_defs);
+	nls_emit_map_free(&em.ner_nodes);
+	nls_emit_map_free(&em.ner_terms);
+	return ret;
+}
+
+/*
+ * Compile term into a function, once. Returns its number.
+ */
+static int
+nls_emit_term(nls_emitter *em, nls_node *term)
+{
+	int n;
+	char *buf;
+	size_t size;
+	nls_emit_func fn;
+
+	if (0 <= (n = nls_emit_map_get(&em->ner_terms, term))) {
+		return n;
+	}
+	n = em->ner_num_terms++;
+	if (nls_emit_map_put(&em->ner_terms, term, n) ||
+		!(fn.nef_out = open_memstream(&buf, &size))) {
+		em->ner_failed = 1;
+		return n;
+	}
+	fn.nef_num_ints = 0;
+	fn.nef_use_v = 0;
+	nls_emit_body(em, &fn, term);
+	fclose(fn.nef_out);
+
+	nls_emit_line(em->ner_protos, 0,
+		"static int nls_aot_t%d(nls_aot_frame *frame, nls_node **out);", n);
+	nls_emit_line(em->ner_funcs, 0, "static int");
+	nls_emit_line(em->ner_funcs, 0,
+		"nls_aot_t%d(nls_aot_frame *frame, nls_node **out)", n);
+	nls_emit_line(em->ner_funcs, 0, "{");
+	if (fn.nef_use_v) {
+		nls_emit_line(em->ner_funcs, 1, "int ret;");
+		nls_emit_line(em->ner_funcs, 1, "nls_node *v;");
+		nls_emit_line(em->ner_funcs, 0, "");
+	}
+	fputs(buf, em->ner_funcs);
+	nls_emit_line(em->ner_funcs, 0, "}");
+	nls_emit_line(em->ner_funcs, 0, "");
+	free(buf);
+	return n;
+}
+
+/*
+ * Statements returning the value of term.
+ */
+static void
+nls_emit_body(nls_emitter *em, nls_emit_func *fn, nls_node *term)
+{
+	char op;
+	int i0, i1, n;
+	nls_node *func, *args, *abst;
+	FILE *out = fn->nef_out;
+	int k = nls_emit_node(em, term);
+
+	switch (NLS_NODE_TYPE(term)) {
+	case NLS_TYPE_VAR:
+		if (0 <= term->nn_var.nv_index) {
+			nls_emit_line(out, 1, "return nls_aot_arg(K(%d), frame, out);", k);
+		} else {
+			nls_emit_line(out, 1, "return nls_aot_global(K(%d), out);", k);
+		}
+		return;
+	case NLS_TYPE_APPLICATION:
+		break;
+	case NLS_TYPE_ABSTRACTION:
+	case NLS_TYPE_LIST:
+		if (!nls_node_closed(term, 0)) {
+			nls_emit_line(out, 1, "return nls_aot_inst(K(%d), frame, out);", k);
+			return;
+		}
+		/* FALLTHROUGH */
+	default:
+		nls_emit_line(out, 1, "return nls_aot_const(K(%d), out);", k);
+		return;
+	}
+	func = term->nn_app.nap_func;
+	args = term->nn_app.nap_args;
+	n = nls_list_count(args);
+	if ((op = nls_emit_arith_op(term))) {
+		i0 = fn->nef_num_ints++;
+		i1 = fn->nef_num_ints++;
+		nls_emit_line(out, 1, "if (nls_aot_holds(K(%d), %s)) {",
+			nls_emit_node(em, func), nls_emit_builtin_name(func));
+		nls_emit_line(out, 2, "int i%d, i%d;", i0, i1);
+		nls_emit_line(out, 0, "");
+		nls_emit_int(em, fn, args->nn_list.nl_head, i0, 2);
+		nls_emit_int(em, fn, args->nn_list.nl_rest->nn_list.nl_head, i1, 2);
+		nls_emit_line(out, 2, "return nls_aot_int(i%d %c i%d, out);",
+			i0, op, i1);
+		nls_emit_line(out, 1, "}");
+	} else if (NLS_ISVAR(func) && nls_func_set == nls_emit_builtin_fp(func) &&
+		2 == n && NLS_ISVAR(args->nn_list.nl_head) &&
+		args->nn_list.nl_head->nn_var.nv_index < 0) {
+		nls_emit_line(out, 1, "if (nls_aot_holds(K(%d), %s)) {",
+			nls_emit_node(em, func), nls_emit_builtin_name(func));
+		nls_emit_line(out, 2, "return nls_aot_set(K(%d), K(%d), frame, out);",
+			nls_emit_node(em, args->nn_list.nl_head),
+			nls_emit_node(em, args->nn_list.nl_rest->nn_list.nl_head));
+		nls_emit_line(out, 1, "}");
+	} else if (NLS_AOT_FRAME_ARGS < n) {
+		/* Left to the interpreter. */
+	} else if (NLS_ISVAR(func) && (abst = nls_emit_def_of(em, func)) &&
+		abst->nn_abst.nab_num_args == n) {
+		nls_emit_call(em, fn, term, abst,
+			nls_emit_term(em, abst->nn_abst.nab_def), "NULL");
+		return;
+	} else if (NLS_TYPE_ABSTRACTION == NLS_NODE_TYPE(func) &&
+		func->nn_abst.nab_num_args == n) {
+		nls_emit_call(em, fn, term, NULL,
+			nls_emit_term(em, func->nn_abst.nab_def), "frame");
+		return;
+	}
+	nls_emit_line(out, 1, "return nls_aot_apply(K(%d), frame, out);", k);
+}
+
+/*
+ * Statements storing the int value of term to i<dest>. The function
+ * fails with EINVAL if it is no int, as the builtins do.
+ */
+static void
+nls_emit_int(nls_emitter *em, nls_emit_func *fn, nls_node *term, int dest, int indent)
+{
+	char op;
+	int i0, i1;
+	nls_node *func, *args;
+	FILE *out = fn->nef_out;
+
+	if (NLS_ISINT(term)) {
+		nls_emit_line(out, indent, "i%d = %d;", dest, NLS_INT_VAL(term));
+		return;
+	}
+	fn->nef_use_v = 1;
+	if (NLS_ISVAR(term)) {
+		if (0 <= term->nn_var.nv_index) {
+			nls_emit_line(out, indent,
+				"NLS_AOT_INT_OF(nls_aot_arg(K(%d), frame, &v), v, i%d);",
+				nls_emit_node(em, term), dest);
+		} else {
+			nls_emit_line(out, indent,
+				"NLS_AOT_INT_OF(nls_aot_global(K(%d), &v), v, i%d);",
+				nls_emit_node(em, term), dest);
+		}
+		return;
+	}
+	if (!(op = nls_emit_arith_op(term))) {
+		nls_emit_line(out, indent,
+			"NLS_AOT_INT_OF(nls_aot_t%d(frame, &v), v, i%d);",
+			nls_emit_term(em, term), dest);
+		return;
+	}
+	/* Nested arithmetic is inline too, behind a guard of its own. */
+	func = term->nn_app.nap_func;
+	args = term->nn_app.nap_args;
+	i0 = fn->nef_num_ints++;
+	i1 = fn->nef_num_ints++;
+	nls_emit_line(out, indent, "if (nls_aot_holds(K(%d), %s)) {",
+		nls_emit_node(em, func), nls_emit_builtin_name(func));
+	nls_emit_line(out, indent + 1, "int i%d, i%d;", i0, i1);
+	nls_emit_line(out, 0, "");
+	nls_emit_int(em, fn, args->nn_list.nl_head, i0, indent + 1);
+	nls_emit_int(em, fn, args->nn_list.nl_rest->nn_list.nl_head, i1,
+		indent + 1);
+	nls_emit_line(out, indent + 1, "i%d = i%d %c i%d;", dest, i0, op, i1);
+	nls_emit_line(out, indent, "} else {");
+	nls_emit_line(out, indent + 1,
+		"NLS_AOT_INT_OF(nls_aot_apply(K(%d), frame, &v), v, i%d);",
+		nls_emit_node(em, term), dest);
+	nls_emit_line(out, indent, "}");
+}
+
+/*
+ * Statements running compiled body in a frame of the arguments of term.
+ * With guard, the global applied must still hold it.
+ */
+static void
+nls_emit_call(nls_emitter *em, nls_emit_func *fn, nls_node *term, nls_node *guard, int body, const char *up)
+{
+	int i = 0;
+	nls_node **item, *tmp;
+	FILE *out = fn->nef_out;
+	int n = nls_list_count(term->nn_app.nap_args);
+
+	nls_emit_line(out, 1, "nls_aot_thunk args[%d];", n);
+	nls_emit_line(out, 0, "");
+	if (guard) {
+		nls_emit_line(out, 1, "if (nls_symbol_get(K(%d)) != K(%d)) {",
+			nls_emit_node(em, term->nn_app.nap_func),
+			nls_emit_node(em, guard));
+		nls_emit_line(out, 2, "return nls_aot_apply(K(%d), frame, out);",
+			nls_emit_node(em, term));
+		nls_emit_line(out, 1, "}");
+	}
+	nls_list_foreach(term->nn_app.nap_args, &item, &tmp) {
+		nls_emit_line(out, 1,
+			"nls_aot_thunk_init(&args[%d], nls_aot_t%d, K(%d), frame);",
+			i++, nls_emit_term(em, *item), nls_emit_node(em, *item));
+	}
+	nls_emit_line(out, 1, "return nls_aot_enter(nls_aot_t%d, args, %d, %s, out);",
+		body, n, up);
+}
+
+static void
+nls_emit_line(FILE *out, int indent, const char *fmt, ...)
+{
+	va_list alist;
+
+	while (indent--) {
+		fputc('\t', out);
+	}
+	va_start(alist, fmt);
+	vfprintf(out, fmt, alist);
+	va_end(alist);
+	fputc('\n', out);
+}
+
+/*
+ * Entry of node in the table built at start-up, once. Returns its index
+ * in K().
+ */
+static int
+nls_emit_node(nls_emitter *em, nls_node *node)
+{
+	int k, a, b;
+	FILE *out = em->ner_table;
+
+	if (0 <= (k = nls_emit_map_get(&em->ner_nodes, node))) {
+		return k;
+	}
+	switch (NLS_NODE_TYPE(node)) {
+	case NLS_TYPE_INT:
+		nls_emit_line(out, 1, "{NLS_TYPE_INT, %d, 0, NULL},",
+			NLS_INT_VAL(node));
+		break;
+	case NLS_TYPE_VAR:
+		nls_emit_line(out, 1, "{NLS_TYPE_VAR, %d, 0, \"%s\"},",
+			node->nn_var.nv_index, node->nn_var.nv_name->ns_buf);
+		break;
+	case NLS_TYPE_ABSTRACTION:
+		a = nls_emit_node(em, node->nn_abst.nab_vars);
+		b = nls_emit_node(em, node->nn_abst.nab_def);
+		nls_emit_line(out, 1, "{NLS_TYPE_ABSTRACTION, %d, %d, NULL},", a, b);
+		break;
+	case NLS_TYPE_APPLICATION:
+		a = nls_emit_node(em, node->nn_app.nap_func);
+		b = nls_emit_node(em, node->nn_app.nap_args);
+		nls_emit_line(out, 1, "{NLS_TYPE_APPLICATION, %d, %d, NULL},", a, b);
+		break;
+	case NLS_TYPE_LIST:
+		a = nls_emit_node(em, node->nn_list.nl_head);
+		b = node->nn_list.nl_rest ?
+			nls_emit_node(em, node->nn_list.nl_rest) : -1;
+		nls_emit_line(out, 1, "{NLS_TYPE_LIST, %d, %d, NULL},", a, b);
+		break;
+	default:
+		/* Builtins are values of globals only, never in a program. */
+		NLS_BUG(NLS_MSG_INVALID_NODE_TYPE ": type=%d", NLS_NODE_TYPE(node));
+		return -1;
+	}
+	/* Entries are written in order, after their parts. */
+	k = em->ner_num_nodes++;
+	if (nls_emit_map_put(&em->ner_nodes, node, k)) {
+		em->ner_failed = 1;
+	}
+	return k;
+}
+
+/*
+ * The builtin a global holds at start-up, or NULL. Nothing has been
+ * evaluated yet, so only builtins are defined.
+ */
+static nls_fp
+nls_emit_builtin_fp(nls_node *var)
+{
+	nls_node *value = nls_symbol_get(var);
+
+	if (!value || NLS_TYPE_FUNCTION != NLS_NODE_TYPE(value)) {
+		return NULL;
+	}
+	return value->nn_func.nf_fp;
+}
+
+/*
+ * C name of the builtin a global holds at start-up.
+ */
+static const char*
+nls_emit_builtin_name(nls_node *var)
+{
+	nls_fp fp = nls_emit_builtin_fp(var);
+
+	if (nls_func_add == fp) {
+		return "nls_func_add";
+	}
+	if (nls_func_sub == fp) {
+		return "nls_func_sub";
+	}
+	if (nls_func_mul == fp) {
+		return "nls_func_mul";
+	}
+	if (nls_func_div == fp) {
+		return "nls_func_div";
+	}
+	if (nls_func_mod == fp) {
+		return "nls_func_mod";
+	}
+	if (nls_func_set == fp) {
+		return "nls_func_set";
+	}
+	NLS_BUG(NLS_MSG_INVALID_NODE_TYPE ": %s", var->nn_var.nv_name->ns_buf);
+	return NULL;
+}
+
+/*
+ * C operator of an application of an arithmetic builtin, or 0.
+ */
+static char
+nls_emit_arith_op(nls_node *app)
+{
+	nls_fp fp;
+	nls_node *func = app->nn_app.nap_func;
+
+	if (!NLS_ISVAR(func) || 2 != nls_list_count(app->nn_app.nap_args)) {
+		return 0;
+	}
+	fp = nls_emit_builtin_fp(func);
+	if (nls_func_add == fp) {
+		return '+';
+	}
+	if (nls_func_sub == fp) {
+		return '-';
+	}
+	if (nls_func_mul == fp) {
+		return '*';
+	}
+	if (nls_func_div == fp) {
+		return '/';
+	}
+	if (nls_func_mod == fp) {
+		return '%';
+	}
+	return 0;
+}
+
+/*
+ * Abstraction a top-level set() of the expressions so far left in a
+ * global, or NULL.
+ */
+static nls_node*
+nls_emit_def_of(nls_emitter *em, nls_node *var)
+{
+	int slot = var->nn_var.nv_slot;
+
+	if (slot < 0 || slot >= em->ner_defs_size) {
+		return NULL;
+	}
+	return em->ner_defs[slot];
+}
+
+/*
+ * Record the definition a top-level expression makes, if any.
+ */
+static void
+nls_emit_define(nls_emitter *em, nls_node *expr)
+{
+	int i, slot, size;
+	nls_node **defs, *func, *var, *def;
+
+	if (!NLS_ISAPP(expr)) {
+		return;
+	}
+	func = expr->nn_app.nap_func;
+	if (!NLS_ISVAR(func) || nls_func_set != nls_emit_builtin_fp(func) ||
+		2 != nls_list_count(expr->nn_app.nap_args)) {
+		return;
+	}
+	var = expr->nn_app.nap_args->nn_list.nl_head;
+	def = expr->nn_app.nap_args->nn_list.nl_rest->nn_list.nl_head;
+	if (!NLS_ISVAR(var) || 0 > (slot = nls_symbol_resolve(var))) {
+		return;
+	}
+	if (slot >= em->ner_defs_size) {
+		for (size = em->ner_defs_size ? em->ner_defs_size : 16;
+			size <= slot; size *= 2)
+			;
+		if (!(defs = realloc(em->ner_defs, size * sizeof(nls_node*)))) {
+			em->ner_failed = 1;
+			return;
+		}
+		for (i = em->ner_defs_size; i < size; i++) {
+			defs[i] = NULL;
+		}
+		em->ner_defs = defs;
+		em->ner_defs_size = size;
+	}
+	if (NLS_TYPE_ABSTRACTION == NLS_NODE_TYPE(def) && nls_node_closed(def, 0)) {
+		em->ner_defs[slot] = def;
+	} else {
+		em->ner_defs[slot] = NULL;
+	}
+}
+
+static uintptr_t
+nls_emit_map_hash(nls_node *key)
+{
+	uint64_t hash = (uintptr_t)key;
+
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	return (uintptr_t)hash;
+}
+
+static int
+nls_emit_map_get(nls_emit_map *map, nls_node *key)
+{
+	uintptr_t i;
+
+	if (!map->nem_size) {
+		return -1;
+	}
+	i = nls_emit_map_hash(key);
+	for (i &= map->nem_size - 1; map->nem_keys[i];
+		i = (i + 1) & (map->nem_size - 1)) {
+		if (map->nem_keys[i] == key) {
+			return map->nem_values[i];
+		}
+	}
+	return -1;
+}
+
+static int
+nls_emit_map_put(nls_emit_map *map, nls_node *key, int value)
+{
+	int j;
+	uintptr_t i;
+	nls_emit_map old = *map;
+
+	if (2 * (map->nem_num + 1) > map->nem_size) {
+		map->nem_size = old.nem_size ? 2 * old.nem_size : NLS_EMIT_MAP_INIT_SIZE;
+		map->nem_keys = calloc(map->nem_size, sizeof(nls_node*));
+		map->nem_values = malloc(map->nem_size * sizeof(int));
+		if (!map->nem_keys || !map->nem_values) {
+			free(map->nem_keys);
+			free(map->nem_values);
+			*map = old;
+			return ENOMEM;
+		}
+		map->nem_num = 0;
+		for (j = 0; j < old.nem_size; j++) {
+			if (old.nem_keys[j]) {
+				nls_emit_map_put(map, old.nem_keys[j], old.nem_values[j]);
+			}
+		}
+		nls_emit_map_free(&old);
+	}
+	i = nls_emit_map_hash(key);
+	for (i &= map->nem_size - 1; map->nem_keys[i];
+		i = (i + 1) & (map->nem_size - 1))
+		;
+	map->nem_keys[i] = key;
+	map->nem_values[i] = value;
+	map->nem_num++;
+	return 0;
+}
+
+static void
+nls_emit_map_free(nls_emit_map *map)
+{
+	free(map->nem_keys);
+	free(map->nem_values);
+}
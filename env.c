@@ -0,0 +1,301 @@
+/*
+ * Nameless - A lambda calculation language.
+ * Copyright (C) 2009 Yoshifumi Shimono <yoshifumi.shimono@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <errno.h>
+#include "nameless.h"
+#include "nameless/node.h"
+#include "nameless/mm.h"
+
+#define NLS_MSG_UNBOUND_INDEX "Unbound variable index"
+
+#define NLS_ENV_STACK_ARGS 4 /* Most arguments of a strict call */
+
+/*
+ * Environment evaluator. Definitions and the program tree are never
+ * rewritten: applying an abstraction binds its arguments in a frame
+ * and evaluates the body as it is. Only values leaving a frame, such as
+ * lists, abstractions and partial applications, are instantiated into
+ * new nodes. Arguments are passed unevaluated, as nls_eval() does.
+ */
+
+/* Arguments bound to the parameters of an abstraction. */
+typedef struct _nls_env {
+	nls_node *ne_args; /* Closed terms */
+	int ne_num_args;
+	int ne_num_params; /* More than ne_num_args if partially applied */
+	struct _nls_env *ne_up;
+} nls_env;
+
+static int nls_env_eval_in(nls_node *term, nls_env *env, nls_node **out);
+static int nls_env_apply(nls_node *func, nls_node *args, nls_env *env, nls_node **out);
+static int nls_env_abstraction_apply(nls_node *func, nls_node *args, nls_env *env, nls_node **out);
+static int nls_env_strict_call(nls_node *func, nls_node *args, nls_env *env, nls_node **out);
+static nls_node* nls_env_lookup(nls_node *var, nls_env *env, int depth);
+static nls_node* nls_env_arg_of(nls_node *var, void *frame, int depth, void **arg_frame);
+
+/**
+ * [DESTRUCTIVE] Evaluate an expression as nls_eval() does, rewriting
+ * *tree only.
+ * @param  tree Target syntax tree.
+ * @retval 0    Evaluation succeed.
+ * @retval else Error code.
+ */
+int
+nls_env_eval(nls_node **tree)
+{
+	int ret;
+	nls_node *out;
+
+	if ((ret = nls_env_eval_in(*tree, NULL, &out))) {
+		return ret;
+	}
+	nls_release(*tree);
+	*tree = out;
+	return 0;
+}
+
+/*
+ * Evaluate term under env. On success, *out holds a reference.
+ */
+static int
+nls_env_eval_in(nls_node *term, nls_env *env, nls_node **out)
+{
+	nls_node *arg, *value;
+
+	switch (NLS_NODE_TYPE(term)) {
+	case NLS_TYPE_VAR:
+		if (0 <= term->nn_var.nv_index) {
+			if (!env) {
+				*out = nls_grab(term); /* Bound, but not applied yet. */
+				return 0;
+			}
+			if (!(arg = nls_env_lookup(term, env, 0))) {
+				return ENOMEM;
+			}
+			return nls_env_eval_in(arg, NULL, out);
+		}
+		value = nls_symbol_get(term);
+		*out = nls_grab(value ? value : term);
+		return 0;
+	case NLS_TYPE_APPLICATION:
+		return nls_env_apply(term->nn_app.nap_func,
+			term->nn_app.nap_args, env, out);
+	default:
+		*out = nls_node_inst(term, env, 0, nls_env_arg_of);
+		return *out ? 0 : ENOMEM;
+	}
+}
+
+/*
+ * Apply func to args under env. Nothing in function position is bound,
+ * so func itself is closed.
+ */
+static int
+nls_env_apply(nls_node *func, nls_node *args, nls_env *env, nls_node **out)
+{
+	int ret;
+	nls_node *value, *actuals, *app;
+
+	switch (NLS_NODE_TYPE(func)) {
+	case NLS_TYPE_VAR:
+		if (!(value = nls_symbol_get(func))) {
+			NLS_ERROR(NLS_MSG_NO_SUCH_SYMBOL ": %s",
+				func->nn_var.nv_name->ns_buf);
+			return EINVAL;
+		}
+		/* Redefining the global inside must not free it. */
+		value = nls_grab(value);
+		ret = nls_env_apply(value, args, env, out);
+		nls_release(value);
+		return ret;
+	case NLS_TYPE_APPLICATION:
+		if ((ret = nls_env_eval_in(func, NULL, &value))) {
+			return ret;
+		}
+		ret = nls_env_apply(value, args, env, out);
+		nls_release(value);
+		return ret;
+	case NLS_TYPE_FUNCTION:
+		if (func->nn_func.nf_strict &&
+			func->nn_func.nf_num_args <= NLS_ENV_STACK_ARGS &&
+			func->nn_func.nf_num_args == nls_list_count(args)) {
+			return nls_env_strict_call(func, args, env, out);
+		}
+		/* Builtins evaluate their arguments in place: pass a copy. */
+		if (!(actuals = nls_node_inst(args, env, 0, nls_env_arg_of))) {
+			return ENOMEM;
+		}
+		if (actuals == args) {
+			nls_release(actuals);
+			if (!(actuals = nls_node_clone(args))) {
+				return ENOMEM;
+			}
+			actuals = nls_grab(actuals);
+		}
+		*out = NULL;
+		if (!(ret = nls_function_call(func, actuals, out))) {
+			*out = nls_grab(*out);
+			if (nls_sys_config.nc_intern) {
+				nls_node_intern(out);
+			}
+		}
+		nls_release(actuals);
+		return ret;
+	case NLS_TYPE_ABSTRACTION:
+		return nls_env_abstraction_apply(func, args, env, out);
+	default:
+		/* Nothing to apply: the application is the value. */
+		if (!(actuals = nls_node_inst(args, env, 0, nls_env_arg_of))) {
+			return ENOMEM;
+		}
+		app = nls_application_new(func, actuals);
+		nls_release(actuals);
+		if (!app) {
+			return ENOMEM;
+		}
+		*out = nls_grab(app);
+		return 0;
+	}
+}
+
+static int
+nls_env_abstraction_apply(nls_node *func, nls_node *args, nls_env *env, nls_node **out)
+{
+	int i, ret;
+	nls_env frame;
+	nls_node *actuals, *vars, *def, *curry;
+	nls_abstraction *abst = &(func->nn_abst);
+	int nargs = nls_list_count(args);
+
+	if (nargs > abst->nab_num_args) {
+		NLS_ERROR(NLS_MSG_TOO_MANY_ARGS ": expected=%d actual=%d",
+			abst->nab_num_args, nargs);
+		return EINVAL;
+	}
+	if (!(actuals = nls_node_inst(args, env, 0, nls_env_arg_of))) {
+		return ENOMEM;
+	}
+	frame.ne_args = actuals;
+	frame.ne_num_args = nargs;
+	frame.ne_num_params = abst->nab_num_args;
+	frame.ne_up = NULL;
+	if (nargs == abst->nab_num_args) {
+		if (!(ret = nls_eval_enter())) {
+			ret = nls_env_eval_in(abst->nab_def, &frame, out);
+			nls_eval_leave();
+		}
+		nls_release(actuals);
+		return ret;
+	}
+	/* Partial apply: the rest of the parameters make a new abstraction. */
+	vars = abst->nab_vars;
+	for (i = 0; i < nargs; i++) {
+		vars = vars->nn_list.nl_rest;
+	}
+	def = nls_node_inst(abst->nab_def, &frame, 0, nls_env_arg_of);
+	nls_release(actuals);
+	if (!def) {
+		return ENOMEM;
+	}
+	curry = nls_abstraction_new_bound(vars, def);
+	nls_release(def);
+	if (!curry) {
+		return ENOMEM;
+	}
+	*out = nls_grab(curry);
+	return 0;
+}
+
+/*
+ * Call a strict builtin with the values of args, without instantiating
+ * the terms. It keeps nothing of its argument list, so the list lives
+ * on the C stack: an arithmetic step allocates nothing.
+ */
+static int
+nls_env_strict_call(nls_node *func, nls_node *args, nls_env *env, nls_node **out)
+{
+	int i, n = 0, ret = 0;
+	nls_node **item, *tmp, *value;
+	nls_node cells[NLS_ENV_STACK_ARGS];
+
+	nls_list_foreach(args, &item, &tmp) {
+		if ((ret = nls_env_eval_in(*item, env, &value))) {
+			break;
+		}
+		nls_list_init(&cells[n], value);
+		nls_release(value);
+		if (n) {
+			cells[n-1].nn_list.nl_rest = &cells[n];
+		}
+		n++;
+	}
+	if (!ret) {
+		*out = NULL;
+		if (!(ret = nls_function_call(func, cells, out))) {
+			*out = nls_grab(*out);
+			if (nls_sys_config.nc_intern) {
+				nls_node_intern(out);
+			}
+		}
+	}
+	for (i = 0; i < n; i++) {
+		nls_release(cells[i].nn_list.nl_head);
+	}
+	return ret;
+}
+
+/*
+ * Argument a bound variable refers to, depth parameters inside env: a
+ * closed term. A parameter left unapplied is renumbered into a new
+ * variable, for the caller to grab.
+ */
+static nls_node*
+nls_env_lookup(nls_node *var, nls_env *env, int depth)
+{
+	nls_node *node, *args;
+	int i = var->nn_var.nv_index - depth;
+
+	for (; env; env = env->ne_up) {
+		if (i < env->ne_num_args) {
+			for (args = env->ne_args; i; i--) {
+				args = args->nn_list.nl_rest;
+			}
+			return args->nn_list.nl_head;
+		}
+		if (i < env->ne_num_params) {
+			/* Left unapplied: renumber for the new abstraction. */
+			if (!(node = nls_node_clone(var))) {
+				return NULL;
+			}
+			node->nn_var.nv_index = depth + i - env->ne_num_args;
+			return node;
+		}
+		i -= env->ne_num_params;
+	}
+	NLS_BUG(NLS_MSG_UNBOUND_INDEX ": %d", var->nn_var.nv_index);
+	return var;
+}
+
+/*
+ * Argument a bound variable refers to, for nls_node_inst().
+ */
+static nls_node*
+nls_env_arg_of(nls_node *var, void *frame, int depth, void **arg_frame)
+{
+	*arg_frame = NULL; /* Closed */
+	return nls_env_lookup(var, frame, depth);
+}
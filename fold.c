@@ -0,0 +1,538 @@
+/*
+ * Nameless - A lambda calculation language.
+ * Copyright (C) 2009 Yoshifumi Shimono <yoshifumi.shimono@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include "nameless.h"
+#include "nameless/node.h"
+#include "nameless/mm.h"
+#include "nameless/function.h"
+
+/*
+ * Folding evaluates, before a term runs, what it would compute the same
+ * whenever it ran: applications of builtins to ints, and of literal
+ * lambdas to ints. Only the spine of a term is folded, the part reduced
+ * for its value as soon as the term is: its function, the arguments of a
+ * strict builtin, and the body an applied lambda reduces to. Arguments
+ * of anything else are passed as they are, and may be printed or set
+ * unreduced.
+ *
+ * A global is folded only while its name is untainted: appears nowhere
+ * in the program scanned so far but in function position, or as the
+ * name a whole top-level expression sets. Only a name passed as an
+ * argument can be set, so an untainted global holds during each
+ * expression; a later expression that taints one, or sets one folded,
+ * starts a new epoch.
+ *
+ * With nc_inline_size, a call of a global holding a small abstraction
+ * is folded too, into its body with the arguments substituted, as a
+ * call reduces to.
+ */
+static unsigned char *nls_fold_tainted; /* By slot */
+static int nls_fold_num_slots;
+static unsigned long nls_fold_gen;
+static int nls_fold_depth; /* Of calls being inlined */
+
+#define NLS_FOLD_MAX_DEPTH 4
+
+static void nls_fold_taint(nls_node *tree, int in_func);
+static nls_node* nls_fold_spine(nls_node *term);
+static nls_node* nls_fold_global(nls_node *func);
+static nls_node* nls_fold_builtin(nls_node *func);
+static nls_node* nls_fold_curry(nls_node *func, nls_node *args);
+static nls_node* nls_fold_call(nls_node *term, nls_node *func);
+static nls_node* nls_fold_inline(nls_node *term);
+static int nls_fold_ints(nls_node *args);
+static int nls_fold_size(nls_node *tree, int limit);
+static int nls_fold_lambdas(nls_node *tree);
+static int nls_fold_open(nls_node *tree);
+static int nls_fold_setter(nls_node *func);
+
+/**
+ * Taint the names expr passes as arguments, before it runs.
+ */
+void
+nls_fold_scan(nls_node *expr)
+{
+	nls_node *args;
+
+	if (NLS_ISAPP(expr) && nls_fold_setter(expr->nn_app.nap_func) &&
+		2 == nls_list_count(args = expr->nn_app.nap_args) &&
+		NLS_ISVAR(args->nn_list.nl_head)) {
+		/* Sets the name between expressions only. */
+		nls_fold_taint(args->nn_list.nl_rest, 0);
+		return;
+	}
+	nls_fold_taint(expr, 0);
+}
+
+/**
+ * Fold the spine of *tree, which nothing else refers to.
+ * @retval 0    Folded, or left as it is.
+ * @retval else Error code.
+ */
+int
+nls_fold(nls_node **tree)
+{
+	nls_node *out = nls_fold_spine(*tree);
+
+	if (!out) {
+		return ENOMEM;
+	}
+	nls_release(*tree);
+	*tree = out;
+	return 0;
+}
+
+/**
+ * The abstraction abst with its body folded, for each call to reduce
+ * a copy of. abst is left as it is.
+ * @return Reference to abst itself if nothing folds, NULL if out of
+ *         memory.
+ */
+nls_node*
+nls_fold_abstraction(nls_node *abst)
+{
+	nls_node *def = abst->nn_abst.nab_def;
+	nls_node *out = nls_fold_spine(def);
+
+	if (!out || out == def) {
+		if (out) {
+			nls_release(out);
+		}
+		return out ? nls_grab(abst) : NULL;
+	}
+	abst = nls_abstraction_new_bound(abst->nn_abst.nab_vars, out);
+	nls_release(out);
+	return abst ? nls_grab(abst) : NULL;
+}
+
+/**
+ * Epoch of the untainted builtins: whatever was folded in an older one
+ * must be folded again.
+ */
+unsigned long
+nls_fold_epoch(void)
+{
+	return nls_fold_gen;
+}
+
+/**
+ * Start a new epoch, as a builtin has been set.
+ */
+void
+nls_fold_invalidate(void)
+{
+	nls_fold_gen++;
+}
+
+void
+nls_fold_term(void)
+{
+	free(nls_fold_tainted);
+	nls_fold_tainted = NULL;
+	nls_fold_num_slots = 0;
+}
+
+static void
+nls_fold_taint(nls_node *tree, int in_func)
+{
+	nls_node **item, *tmp;
+	int slot;
+
+	switch (NLS_NODE_TYPE(tree)) {
+	case NLS_TYPE_VAR:
+		if (in_func || 0 <= tree->nn_var.nv_index ||
+			0 > (slot = nls_symbol_resolve(tree))) {
+			return;
+		}
+		if (slot >= nls_fold_num_slots) {
+			int size = nls_fold_num_slots ? 2 * nls_fold_num_slots : 64;
+			unsigned char *tainted;
+
+			while (size <= slot) {
+				size *= 2;
+			}
+			if (!(tainted = realloc(nls_fold_tainted, size))) {
+				/* Nothing folds without the table. */
+				NLS_ERROR(NLS_MSG_ENOMEM);
+				return;
+			}
+			memset(tainted + nls_fold_num_slots, 0, size - nls_fold_num_slots);
+			nls_fold_tainted = tainted;
+			nls_fold_num_slots = size;
+		}
+		if (!nls_fold_tainted[slot]) {
+			nls_fold_tainted[slot] = 1;
+			nls_fold_gen++;
+		}
+		return;
+	case NLS_TYPE_ABSTRACTION:
+		nls_fold_taint(tree->nn_abst.nab_def, 0);
+		return;
+	case NLS_TYPE_APPLICATION:
+		nls_fold_taint(tree->nn_app.nap_func, 1);
+		nls_fold_taint(tree->nn_app.nap_args, 0);
+		return;
+	case NLS_TYPE_LIST:
+		nls_list_foreach(tree, &item, &tmp) {
+			nls_fold_taint(*item, 0);
+		}
+		return;
+	default:
+		return;
+	}
+}
+
+/*
+ * term with its spine folded.
+ * @return Reference to a new term or to term itself, NULL if out of
+ *         memory.
+ */
+static nls_node*
+nls_fold_spine(nls_node *term)
+{
+	nls_node *func, *args, *new, *out;
+
+	if (!NLS_ISAPP(term)) {
+		return nls_grab(term);
+	}
+	func = term->nn_app.nap_func;
+	args = term->nn_app.nap_args;
+	if (NLS_ISAPP(func)) {
+		if ((new = nls_fold_curry(func, args))) {
+			new = nls_grab(new);
+		} else if (!(out = nls_fold_spine(func))) {
+			return NULL;
+		} else if (out == func) {
+			nls_release(out);
+			return nls_grab(term);
+		} else {
+			new = nls_application_new(out, args);
+			nls_release(out);
+			if (!new) {
+				return NULL;
+			}
+			new = nls_grab(new);
+		}
+		/* The function has changed: the application may fold now. */
+		out = nls_fold_spine(new);
+		nls_release(new);
+		return out;
+	}
+	if (NLS_TYPE_ABSTRACTION == NLS_NODE_TYPE(func)) {
+		if (func->nn_abst.nab_num_args != nls_list_count(args) ||
+			!nls_fold_ints(args)) {
+			return nls_grab(term);
+		}
+		if (!(new = nls_abstraction_instantiate(func, args))) {
+			return NULL;
+		}
+		out = nls_fold_spine(new);
+		nls_release(new);
+		return out;
+	}
+	if ((new = nls_fold_builtin(func))) {
+		return nls_fold_call(term, new);
+	}
+	if (nls_sys_config.nc_inline_size) {
+		return nls_fold_inline(term);
+	}
+	return nls_grab(term);
+}
+
+/*
+ * The value of the global func names, if untainted.
+ */
+static nls_node*
+nls_fold_global(nls_node *func)
+{
+	int slot;
+
+	if (!NLS_ISVAR(func) || 0 <= func->nn_var.nv_index ||
+		0 > (slot = nls_symbol_resolve(func)) ||
+		(slot < nls_fold_num_slots && nls_fold_tainted[slot])) {
+		return NULL;
+	}
+	return nls_symbol_get(func);
+}
+
+/*
+ * The builtin func names, if it may be folded: a strict one, untainted.
+ */
+static nls_node*
+nls_fold_builtin(nls_node *func)
+{
+	nls_node *node = nls_fold_global(func);
+
+	if (!node || NLS_TYPE_FUNCTION != NLS_NODE_TYPE(node) ||
+		!node->nn_func.nf_strict) {
+		return NULL;
+	}
+	return node;
+}
+
+/*
+ * Merge the application of a curried builtin, func, to args into one
+ * application, if that makes a full call.
+ * @return The application, NULL if not merged or out of memory.
+ */
+static nls_node*
+nls_fold_curry(nls_node *func, nls_node *args)
+{
+	nls_node *builtin, *first, *merged, *new, **item, *tmp;
+
+	if (!(builtin = nls_fold_builtin(func->nn_app.nap_func))) {
+		return NULL;
+	}
+	first = func->nn_app.nap_args;
+	if (builtin->nn_func.nf_num_args !=
+		nls_list_count(first) + nls_list_count(args)) {
+		return NULL;
+	}
+	merged = NULL;
+	nls_list_foreach(first, &item, &tmp) {
+		if (!merged) {
+			if (!(merged = nls_list_new(*item))) {
+				return NULL;
+			}
+			merged = nls_grab(merged);
+		} else if (nls_list_add(merged, *item)) {
+			nls_release(merged);
+			return NULL;
+		}
+	}
+	nls_list_foreach(args, &item, &tmp) {
+		if (nls_list_add(merged, *item)) {
+			nls_release(merged);
+			return NULL;
+		}
+	}
+	new = nls_application_new(func->nn_app.nap_func, merged);
+	nls_release(merged);
+	return new;
+}
+
+/*
+ * Fold the application term of builtin, by calling it if its
+ * arguments fold to ints.
+ */
+static nls_node*
+nls_fold_call(nls_node *term, nls_node *builtin)
+{
+	nls_node *args = term->nn_app.nap_args;
+	nls_node *folded = NULL, *new, **item, *tmp, *out;
+	nls_fp fp = builtin->nn_func.nf_fp;
+	int changed = 0;
+
+	if (builtin->nn_func.nf_num_args != nls_list_count(args)) {
+		return nls_grab(term);
+	}
+	nls_list_foreach(args, &item, &tmp) {
+		if (!(new = nls_fold_spine(*item))) {
+			goto enomem;
+		}
+		changed |= new != *item;
+		if (!folded) {
+			folded = nls_list_new(new);
+			if (folded) {
+				folded = nls_grab(folded);
+			}
+		} else if (nls_list_add(folded, new)) {
+			nls_release(folded);
+			folded = NULL;
+		}
+		nls_release(new);
+		if (!folded) {
+			goto enomem;
+		}
+	}
+	if (nls_fold_ints(folded) && !((fp == nls_func_div || fp == nls_func_mod) &&
+		!NLS_INT_VAL(folded->nn_list.nl_rest->nn_list.nl_head))) {
+		out = NULL;
+		if (nls_function_call(builtin, folded, &out)) {
+			nls_release(folded);
+			return NULL;
+		}
+		out = nls_grab(out);
+		nls_release(folded);
+		return out;
+	}
+	if (!changed) {
+		nls_release(folded);
+		return nls_grab(term);
+	}
+	new = nls_application_new(term->nn_app.nap_func, folded);
+	nls_release(folded);
+	return new ? nls_grab(new) : NULL;
+enomem:
+	NLS_ERROR(NLS_MSG_ENOMEM);
+	return NULL;
+}
+
+/*
+ * Inline the call term of a global, if it holds an abstraction of at
+ * most nc_inline_size nodes taking as many arguments.
+ */
+static nls_node*
+nls_fold_inline(nls_node *term)
+{
+	nls_node *func = term->nn_app.nap_func;
+	nls_node *args = term->nn_app.nap_args;
+	nls_node *def, *body, *out;
+
+	if (NLS_FOLD_MAX_DEPTH <= nls_fold_depth) {
+		return nls_grab(term);
+	}
+	def = nls_fold_global(func);
+	if (!def || NLS_TYPE_ABSTRACTION != NLS_NODE_TYPE(def) ||
+		def->nn_abst.nab_num_args != nls_list_count(args) ||
+		nls_sys_config.nc_inline_size <
+			nls_fold_size(def->nn_abst.nab_def,
+				nls_sys_config.nc_inline_size + 1)) {
+		return nls_grab(term);
+	}
+	if (nls_fold_open(args) && nls_fold_lambdas(def->nn_abst.nab_def)) {
+		/*
+		 * Parameters of the caller in args would be renumbered under
+		 * the lambdas of the body; calls never pass any.
+		 */
+		return nls_grab(term);
+	}
+	if (!(body = nls_abstraction_instantiate(def, args))) {
+		return NULL;
+	}
+	nls_symbol_inlined(func);
+	nls_fold_depth++;
+	out = nls_fold_spine(body);
+	nls_fold_depth--;
+	nls_release(body);
+	return out;
+}
+
+/*
+ * Nonzero if every one of args is an int.
+ */
+static int
+nls_fold_ints(nls_node *args)
+{
+	nls_node **item, *tmp;
+
+	nls_list_foreach(args, &item, &tmp) {
+		if (!NLS_ISINT(*item)) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ * Nodes of tree, counted up to limit at most.
+ */
+static int
+nls_fold_size(nls_node *tree, int limit)
+{
+	nls_node **item, *tmp;
+	int n;
+
+	switch (NLS_NODE_TYPE(tree)) {
+	case NLS_TYPE_ABSTRACTION:
+		return 1 + nls_fold_size(tree->nn_abst.nab_def, limit - 1);
+	case NLS_TYPE_APPLICATION:
+		n = 1 + nls_fold_size(tree->nn_app.nap_func, limit - 1);
+		return n >= limit ? n :
+			n + nls_fold_size(tree->nn_app.nap_args, limit - n);
+	case NLS_TYPE_LIST:
+		n = 0;
+		nls_list_foreach(tree, &item, &tmp) {
+			if ((n += nls_fold_size(*item, limit - n)) >= limit) {
+				break;
+			}
+		}
+		return n;
+	default:
+		return 1;
+	}
+}
+
+/*
+ * Nonzero if tree has an abstraction in it.
+ */
+static int
+nls_fold_lambdas(nls_node *tree)
+{
+	nls_node **item, *tmp;
+
+	switch (NLS_NODE_TYPE(tree)) {
+	case NLS_TYPE_ABSTRACTION:
+		return 1;
+	case NLS_TYPE_APPLICATION:
+		return nls_fold_lambdas(tree->nn_app.nap_func) ||
+			nls_fold_lambdas(tree->nn_app.nap_args);
+	case NLS_TYPE_LIST:
+		nls_list_foreach(tree, &item, &tmp) {
+			if (nls_fold_lambdas(*item)) {
+				return 1;
+			}
+		}
+		return 0;
+	default:
+		return 0;
+	}
+}
+
+/*
+ * Nonzero if tree refers to a parameter of an enclosing abstraction.
+ */
+static int
+nls_fold_open(nls_node *tree)
+{
+	nls_node **item, *tmp;
+
+	switch (NLS_NODE_TYPE(tree)) {
+	case NLS_TYPE_VAR:
+		return 0 <= tree->nn_var.nv_index;
+	case NLS_TYPE_ABSTRACTION:
+		return 1; /* Maybe */
+	case NLS_TYPE_APPLICATION:
+		return nls_fold_open(tree->nn_app.nap_func) ||
+			nls_fold_open(tree->nn_app.nap_args);
+	case NLS_TYPE_LIST:
+		nls_list_foreach(tree, &item, &tmp) {
+			if (nls_fold_open(*item)) {
+				return 1;
+			}
+		}
+		return 0;
+	default:
+		return 0;
+	}
+}
+
+/*
+ * Nonzero if func names the builtin set(), untainted.
+ */
+static int
+nls_fold_setter(nls_node *func)
+{
+	nls_node *node = nls_fold_global(func);
+
+	return node && NLS_TYPE_FUNCTION == NLS_NODE_TYPE(node) &&
+		nls_func_set == node->nn_func.nf_fp;
+}
@@ -71,13 +71,18 @@ int
 nls_func_abst(nls_node *arg, nls_node **out)
 {
 	int ret;
-	nls_node *node, **abst_vars, **abst_def;
+	nls_node *node, *def, **abst_vars, **abst_def;
 
 	if ((ret = nls_argn_get(arg, 2, &abst_vars, &abst_def))) {
 		return ret;
 	}
-	node = nls_abstraction_new(*abst_vars, *abst_def);
+	/* Binding rewrites the variables of the body, which may be shared. */
+	if (!(def = nls_node_clone(*abst_def))) {
+		return ENOMEM;
+	}
+	node = nls_abstraction_new(*abst_vars, def);
 	if (!node) {
+		nls_node_free(def);
 		return ENOMEM;
 	}
 	*out = node;
@@ -96,12 +101,36 @@ nls_func_set(nls_node *arg, nls_node **out)
 	if (!NLS_ISVAR(*var)) {
 		return EINVAL;
 	}
-	nls_symbol_set((*var)->nn_var.nv_name, *def);
-	nls_release(var);
+	nls_symbol_set(*var, *def);
 	*out = *def;
 	return 0;
 }
 
+/*
+ * memo(f): remember the results of the current definition of f, an
+ * abstraction of ints to an int. A call whose arguments are already
+ * ints, until a global is set again, reuses the result of a call with
+ * the same values; other calls run as usual. Only for definitions with
+ * no side effects.
+ */
+int
+nls_func_memo(nls_node *arg, nls_node **out)
+{
+	int ret;
+	nls_node **var, *def;
+
+	if ((ret = nls_argn_get(arg, 1, &var))) {
+		return ret;
+	}
+	if (!NLS_ISVAR(*var) || !(def = nls_symbol_get(*var)) ||
+		NLS_TYPE_ABSTRACTION != NLS_NODE_TYPE(def)) {
+		return EINVAL;
+	}
+	nls_symbol_memoize(*var);
+	*out = def;
+	return 0;
+}
+
 static int
 _nls_int2_func(nls_fp fp, char *name, nls_int2_op op, nls_node *args, nls_node **out)
 {
@@ -126,19 +155,12 @@ _nls_int2_func(nls_fp fp, char *name, nls_int2_op op, nls_node *args, nls_node *
 static int
 __nls_int2_func(nls_node *arg1, nls_node *arg2, nls_int2_op op, nls_node **out)
 {
-	nls_node *node;
-	int result;
-
 	if (!NLS_ISINT(arg1) || !NLS_ISINT(arg2)) {
 		return EINVAL;
 	}
-	result = (op)(NLS_INT_VAL(arg1), NLS_INT_VAL(arg2));
-	node = nls_int_new(result);
-	if (!node) {
-		return ENOMEM;
-	}
-	*out = node;
-	return 0;
+	/* Mostly an immediate; the caller drops the application reduced. */
+	*out = nls_int_new((op)(NLS_INT_VAL(arg1), NLS_INT_VAL(arg2)));
+	return *out ? 0 : ENOMEM;
 }
 
 static int
@@ -28,6 +28,7 @@
 #define NLS_MSG_INVALID_NODE_TYPE "Invalid node type"
 #define NLS_MSG_INVALID_REFCOUNT  "Invalid reference count"
 #define NLS_MSG_NOT_IMPLEMENTED   "Not implemented yet"
+#define NLS_MSG_NO_SUCH_SYMBOL    "No such symbol"
 #define NLS_MSG_TOO_MANY_ARGS     "Too many arguments"
 #define NLS_MSG_ENOMEM "Failed to allocate memory"
 
@@ -70,14 +71,65 @@
 	NLS_ASSERT((expected) != (actual))
 #endif /* NLS_UNIT_TEST */
 
+typedef enum {
+	NLS_EVAL_SUBST = 0, /* Substitute into a copy of each definition */
+	NLS_EVAL_ENV,       /* Bind arguments in environment frames */
+	NLS_EVAL_VM,        /* Compile to bytecode, as NLS_EVAL_ENV */
+	NLS_EVAL_CLOSURE,   /* Compile to C closures, as NLS_EVAL_ENV */
+} nls_eval_mode;
+
+typedef struct _nls_config {
+	int nc_arena; /* Allocate each top-level expression from an arena */
+	int nc_free_budget; /* Objects freed per release/allocation, 0: all */
+	int nc_deferred; /* Free unreferenced objects at safe points only */
+	int nc_nursery_size; /* Bytes allocated between collections (NLS_GC) */
+	int nc_stats; /* Print memory statistics on exit */
+	nls_eval_mode nc_eval; /* Evaluator */
+	int nc_intern; /* Share equal immutable nodes (not NLS_EVAL_SUBST) */
+	int nc_emit_c; /* Write the program as C instead of running it */
+	int nc_tier_threshold; /* Calls before a global runs compiled, 0: never */
+	int nc_max_depth; /* Nested reductions, 0: default */
+	int nc_fold; /* Fold constant builtin calls and literal lambdas */
+	int nc_inline_size; /* Nodes of an abstraction inlined (nc_fold), 0: none */
+} nls_config;
+
 extern FILE *nls_sys_out;
 extern FILE *nls_sys_err;
+extern nls_config nls_sys_config;
 
 int nls_main(FILE *in, FILE *out, FILE *err);
 void nls_init(FILE *out, FILE *err);
 void nls_term(void);
 int nls_eval(nls_node **tree);
-nls_node* nls_symbol_get(nls_string *name);
-void nls_symbol_set(nls_string *name, nls_node *node);
+int nls_eval_enter(void);
+void nls_eval_leave(void);
+int nls_env_eval(nls_node **tree);
+int nls_vm_eval(nls_node **tree);
+void nls_vm_term(void);
+int nls_closure_eval(nls_node **tree);
+void nls_closure_forget(nls_node *abst);
+void nls_closure_safepoint(void);
+void nls_closure_term(void);
+int nls_emit_c(nls_node *prog, FILE *out);
+struct _nls_memo_key;
+int nls_memo_find(nls_node *def, nls_node *args, nls_node **out, struct _nls_memo_key **key);
+void nls_memo_store(struct _nls_memo_key *key, nls_node *value);
+void nls_memo_invalidate(void);
+void nls_memo_safepoint(void);
+void nls_memo_term(void);
+void nls_memo_stat_print(FILE *out);
+void nls_fold_scan(nls_node *expr);
+int nls_fold(nls_node **tree);
+nls_node* nls_fold_abstraction(nls_node *abst);
+unsigned long nls_fold_epoch(void);
+void nls_fold_invalidate(void);
+void nls_fold_term(void);
+int nls_symbol_resolve(nls_node *var);
+nls_node* nls_symbol_get(nls_node *var);
+void nls_symbol_set(nls_node *var, nls_node *node);
+int nls_symbol_hot(nls_node *var);
+void nls_symbol_memoize(nls_node *var);
+void nls_symbol_inlined(nls_node *var);
+nls_node* nls_symbol_folded(nls_node *var);
 
 #endif /* _NAMELESS_H_ */
@@ -0,0 +1,85 @@
+#ifndef _NAMELESS_AOT_H_
+#define _NAMELESS_AOT_H_
+
+/*
+ * Nameless - A lambda calculation language.
+ * Copyright (C) 2009 Yoshifumi Shimono <yoshifumi.shimono@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "nameless/node.h"
+#include "nameless/function.h"
+
+/*
+ * Runtime of the C programs nameless --emit-c generates (see emit.c).
+ * A compiled term is a function evaluating it in a frame of thunks, as
+ * the environment evaluator would.
+ */
+
+#define NLS_AOT_FRAME_ARGS 8 /* Most arguments of a compiled call */
+
+struct _nls_aot_frame;
+
+typedef int (*nls_aot_fp)(struct _nls_aot_frame*, nls_node**);
+
+/* A parameter: the compiled argument and the frame to run it in. */
+typedef struct _nls_aot_thunk {
+	nls_aot_fp nat_fp;
+	nls_node *nat_term;
+	struct _nls_aot_frame *nat_frame;
+} nls_aot_thunk;
+
+/*
+ * A node of the program, built at start-up. Parts are indices of nodes
+ * built before it.
+ */
+typedef struct _nls_aot_node {
+	int nan_type;
+	int nan_a; /* Int value, var index, or first part */
+	int nan_b; /* Second part, -1 for the end of a list */
+	char *nan_name; /* Var name */
+} nls_aot_node;
+
+typedef struct _nls_aot_frame {
+	nls_aot_thunk *naf_args;
+	int naf_num_args;
+	struct _nls_aot_frame *naf_up;
+} nls_aot_frame;
+
+/* Store the int value of call, which sets v, to dest. */
+#define NLS_AOT_INT_OF(call, v, dest) \
+	do { \
+		if ((ret = (call))) { \
+			return ret; \
+		} \
+		if ((ret = nls_aot_int_of((v), &(dest)))) { \
+			return ret; \
+		} \
+	} while (0)
+
+int nls_aot_main(const nls_aot_node *spec, nls_node **nodes, int num_nodes, nls_aot_fp *exprs);
+int nls_aot_holds(nls_node *var, nls_fp fp);
+int nls_aot_const(nls_node *node, nls_node **out);
+int nls_aot_global(nls_node *var, nls_node **out);
+int nls_aot_arg(nls_node *var, nls_aot_frame *frame, nls_node **out);
+int nls_aot_inst(nls_node *term, nls_aot_frame *frame, nls_node **out);
+int nls_aot_int(int val, nls_node **out);
+int nls_aot_int_of(nls_node *value, int *val);
+int nls_aot_set(nls_node *var, nls_node *def, nls_aot_frame *frame, nls_node **out);
+int nls_aot_apply(nls_node *app, nls_aot_frame *frame, nls_node **out);
+void nls_aot_thunk_init(nls_aot_thunk *thunk, nls_aot_fp fp, nls_node *term, nls_aot_frame *frame);
+int nls_aot_enter(nls_aot_fp body, nls_aot_thunk *args, int n, nls_aot_frame *up, nls_node **out);
+
+#endif /* _NAMELESS_AOT_H_ */
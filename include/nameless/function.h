@@ -38,5 +38,6 @@ int nls_func_div(nls_node*, nls_node**);
 int nls_func_mod(nls_node*, nls_node**);
 int nls_func_abst(nls_node*, nls_node**);
 int nls_func_set(nls_node*, nls_node**);
+int nls_func_memo(nls_node*, nls_node**);
 
 #endif /* _NAMELESS_FUNCTION_H_ */
@@ -25,15 +25,39 @@
 
 #define NLS_MAGIC_MEMCHUNK         0x23153e3c /* NMlS_MeMc */
 #define NLS_MAGIC_MEMCHAIN_REMOVED 0x23153c20 /* NMlS_McNO */
+#define NLS_MAGIC_ARENACHUNK       0x23153a2c /* NMlS_ArNc */
 
-#define nls_new(type) (type*)_nls_malloc(sizeof(type), #type, type##_free)
+#if defined(NLS_GC) && defined(NLS_RELEASE)
+# error "NLS_GC and NLS_RELEASE are exclusive"
+#endif
+
+/*
+ * GC builds (NLS_GC) register a trace op per type instead of a free op.
+ * A trace op hands every managed pointer of the object to nls_gc_visit().
+ */
+#ifdef NLS_GC
+# define NLS_MEM_OP(type) type##_trace
+#else
+# define NLS_MEM_OP(type) type##_free
+#endif /* NLS_GC */
+
+#define nls_new(type) \
+	(type*)_nls_malloc(sizeof(type), #type, NLS_MEM_OP(type))
+/* For a type ending with a flexible array member of n bytes. */
+#define nls_new_ext(type, n) \
+	(type*)_nls_malloc(sizeof(type) + (n), #type, NLS_MEM_OP(type))
 #define nls_array_new(type, n) \
-	(type*)_nls_malloc((sizeof(type) * (n)), "array:" #type, nls_array_free)
+	(type*)_nls_malloc((sizeof(type) * (n)), "array:" #type, \
+		NLS_MEM_OP(nls_array))
+
+/* Immediate values (see NLS_ISIMM()) in place of an object pointer. */
+#define NLS_MEM_IS_IMMEDIATE(ptr) ((uintptr_t)(ptr) & 1)
 
 #define nls_release(ptr) _nls_release((ptr), __FILE__, __LINE__, __FUNCTION__)
 #define nls_free(ptr) _nls_free((ptr), __FILE__, __LINE__, __FUNCTION__)
 
 typedef void (*nls_free_op)(void *ptr);
+typedef void (*nls_gc_root_op)(void);
 /**
  * Structure leading dynamic data area.
  *
@@ -45,7 +69,28 @@ typedef void (*nls_free_op)(void *ptr);
  *  |                |
  *  |      ...       |
  *  +----------------+
+ *
+ * Release builds (NLS_RELEASE) shrink the header to a reference count
+ * plus table indexes, and drop memchain tracking and sanity checks.
+ * GC builds (NLS_GC) have no reference count; the memchain links the
+ * old space and nm_next doubles as the forwarding address of a nursery
+ * object that has been promoted.
  */
+#if defined(NLS_GC)
+typedef struct _nls_mem {
+	struct _nls_mem *nm_next;
+	struct _nls_mem *nm_prev;
+	uint32_t nm_flags;
+	uint32_t nm_size;
+	nls_free_op nm_trace_op;
+} nls_mem;
+#elif defined(NLS_RELEASE)
+typedef struct _nls_mem {
+	int nm_ref;
+	uint16_t nm_class; /* Slab size class */
+	uint16_t nm_op;    /* Index of the free op / type name table */
+} nls_mem;
+#else
 typedef struct _nls_mem {
 	struct _nls_mem *nm_next;
 	struct _nls_mem *nm_prev;
@@ -55,13 +100,41 @@ typedef struct _nls_mem {
 	const char *nm_type;
 	nls_free_op nm_free_op;
 } nls_mem;
+#endif /* NLS_RELEASE */
 
 int  nls_mem_chain_init(void);
 void nls_mem_chain_term(void);
 void* nls_grab(void *ptr);
+int nls_is_unique(void *ptr);
 void _nls_release(void *ptr, const char *file, int line, const char *func);
 void _nls_free(void *ptr, const char *file, int line, const char *func);
 void nls_array_free(void *ptr);
 void* _nls_malloc(size_t size, const char *type, nls_free_op free_op);
+void nls_mem_set_free_budget(int budget);
+void nls_mem_set_deferred(int deferred);
+void nls_mem_flush(void);
+void nls_mem_safepoint(void);
+int  nls_mem_safepoint_due(void);
+void nls_arena_begin(void);
+void nls_arena_end(void);
+int  nls_arena_active(void);
+void nls_arena_suspend(void);
+void nls_arena_resume(void);
+unsigned long nls_mem_live(void);
+void nls_mem_stat_print(FILE *out);
+#ifdef NLS_GC
+void nls_array_trace(void *ptr);
+void nls_gc_visit(void *slot);
+void nls_gc_write(void *ptr);
+void nls_gc_root_add(nls_gc_root_op op);
+void nls_gc_root_push(void *slot);
+void nls_gc_root_pop(void);
+void nls_gc_set_nursery_size(size_t size);
+#else
+# define nls_gc_root_push(slot)       ((void)0)
+# define nls_gc_root_pop()            ((void)0)
+# define nls_gc_write(ptr)            ((void)0)
+# define nls_gc_set_nursery_size(size) ((void)0)
+#endif /* NLS_GC */
 
 #endif /* _NAMELESS_MM_H_ */
@@ -20,13 +20,29 @@
  */
 
 #include <stdio.h>
+#include <stdint.h>
 #include "nameless/string.h"
 
-#define NLS_ISINT(node)  (NLS_TYPE_INT == (node)->nn_type)
-#define NLS_ISVAR(node)  (NLS_TYPE_VAR == (node)->nn_type)
-#define NLS_ISAPP(node)  (NLS_TYPE_APPLICATION == (node)->nn_type)
-#define NLS_ISLIST(node) (NLS_TYPE_LIST == (node)->nn_type)
-#define NLS_INT_VAL(node) ((node)->nn_int)
+/*
+ * Ints are immediates where they fit: the value shifted left with the
+ * low bit set stands in for the node pointer. No node address has that
+ * bit, and the memory functions ignore such pointers. An immediate is
+ * never dereferenced, so test the type of any node with NLS_NODE_TYPE().
+ */
+#define NLS_ISIMM(node) ((uintptr_t)(node) & 1)
+#define NLS_IMM_INT_FITS(val) (sizeof(intptr_t) > sizeof(int) \
+	|| (INTPTR_MIN / 2 <= (val) && (val) <= INTPTR_MAX / 2))
+#define NLS_IMM_INT(val) \
+	((struct _nls_node*)(((uintptr_t)(intptr_t)(val) << 1) | 1))
+#define NLS_NODE_TYPE(node) \
+	(NLS_ISIMM(node) ? NLS_TYPE_INT : (node)->nn_type)
+
+#define NLS_ISINT(node)  (NLS_TYPE_INT == NLS_NODE_TYPE(node))
+#define NLS_ISVAR(node)  (NLS_TYPE_VAR == NLS_NODE_TYPE(node))
+#define NLS_ISAPP(node)  (NLS_TYPE_APPLICATION == NLS_NODE_TYPE(node))
+#define NLS_ISLIST(node) (NLS_TYPE_LIST == NLS_NODE_TYPE(node))
+#define NLS_INT_VAL(node) \
+	(NLS_ISIMM(node) ? (int)((intptr_t)(node) >> 1) : (node)->nn_int)
 
 typedef enum {
 	NLS_TYPE_INT = 1,
@@ -38,13 +54,21 @@ typedef enum {
 } nls_node_type_t;
 
 struct _nls_node;
+/*
+ * A variable bound by an abstraction refers to its parameter by a
+ * de Bruijn index: the parameters of the innermost enclosing abstraction
+ * come first, in order, then those of the next one out. The name is only
+ * kept for printing.
+ */
 typedef struct _nls_var {
-	struct _nls_node **nv_next_ref;
 	nls_string *nv_name;
+	int nv_slot;  /* Global slot, -1 until resolved */
+	int nv_index; /* -1 if free */
 } nls_var;
 
 typedef struct _nls_abstraction {
 	int nab_num_args;
+	uint32_t nab_code; /* Compiled body (closure.c), 0 if none */
 	struct _nls_node *nab_vars;
 	struct _nls_node *nab_def;
 } nls_abstraction;
@@ -59,10 +83,16 @@ typedef struct _nls_list {
 	struct _nls_node *nl_rest;
 } nls_list;
 
+/*
+ * Builtin function: reduce args to *out. On entry, *out is either NULL or
+ * the uniquely referenced application being reduced, which the builtin
+ * may recycle in place for its result.
+ */
 typedef int (*nls_fp)(struct _nls_node*, struct _nls_node**);
 
 typedef struct _nls_function {
 	int nf_num_args;
+	int nf_strict; /* Evaluates every argument first, keeps no list */
 	nls_string *nf_name;
 	nls_fp nf_fp;
 } nls_function;
@@ -70,8 +100,14 @@ typedef struct _nls_function {
 typedef void (*nls_node_op_release)(struct _nls_node*);
 typedef struct _nls_node* (*nls_node_op_clone)(struct _nls_node*);
 typedef void (*nls_node_op_print)(struct _nls_node*, FILE*);
+/*
+ * An apply op returns NLS_EVAL_AGAIN when it has replaced the tree with a
+ * term to reduce in its place, such as the body of an abstraction.
+ */
+#define NLS_EVAL_AGAIN (-1)
 typedef int (*nls_node_op_apply)(struct _nls_node**);
-typedef void (*nls_node_op_bound_vars)(struct _nls_node**, struct _nls_node*);
+typedef void (*nls_node_op_bound_vars)(struct _nls_node*, struct _nls_node*, int);
+typedef void (*nls_node_op_subst)(struct _nls_node**, struct _nls_node*, int, int);
 
 typedef struct _nls_node_operations {
 	nls_node_op_release nop_release;
@@ -79,10 +115,16 @@ typedef struct _nls_node_operations {
 	nls_node_op_print nop_print;
 	nls_node_op_apply nop_apply;
 	nls_node_op_bound_vars nop_bound_vars;
+	nls_node_op_subst nop_subst;
 } nls_node_operations;
 
+/*
+ * Interned nodes (see nls_node_intern()) are shared and must never be
+ * rewritten in place.
+ */
 typedef struct _nls_node {
 	nls_node_type_t nn_type;
+	uint32_t nn_hash; /* Nonzero once interned */
 	nls_node_operations *nn_op;
 	union {
 		int nnu_int;
@@ -94,6 +136,13 @@ typedef struct _nls_node {
 	} nn_u;
 } nls_node;
 
+/*
+ * For nls_node_inst(): the argument the bound variable var refers to,
+ * depth parameters inside frame, and in *arg_frame the frame to
+ * instantiate it in. NULL if var is unbound.
+ */
+typedef nls_node* (*nls_node_lookup)(nls_node *var, void *frame, int depth, void **arg_frame);
+
 #define nn_int  nn_u.nnu_int
 #define nn_var  nn_u.nnu_var
 #define nn_list nn_u.nnu_list
@@ -132,13 +181,26 @@ typedef struct _nls_node {
 	) \
 
 void nls_node_free(void *ptr);
+void nls_node_trace(void *ptr);
 nls_node* nls_int_new(int val);
+nls_node* nls_int_box(int val);
 nls_node* nls_var_new(nls_string *name);
-nls_node* nls_function_new(nls_fp fp, int num_args, char *name);
+nls_node* nls_function_new(nls_fp fp, int num_args, int strict, char *name);
 nls_node* nls_abstraction_new(nls_node *vars, nls_node *def);
+nls_node* nls_abstraction_new_bound(nls_node *vars, nls_node *def);
 nls_node* nls_application_new(nls_node *func, nls_node *args);
+nls_node* nls_abstraction_instantiate(nls_node *abst, nls_node *args);
 nls_node* nls_list_new(nls_node *node);
+void nls_list_init(nls_node *cell, nls_node *item);
 nls_node* nls_node_clone(nls_node *tree);
+nls_node* nls_node_inst(nls_node *term, void *frame, int depth, nls_node_lookup lookup);
+int nls_node_closed(nls_node *term, int depth);
+int nls_node_intern(nls_node **tree);
+int nls_node_equal(nls_node *node1, nls_node *node2);
+void nls_node_table_init(void);
+void nls_node_table_term(void);
+void nls_node_table_sweep(void);
+int nls_function_call(nls_node *func, nls_node *args, nls_node **out);
 void nls_node_print(nls_node *node, FILE* out);
 int nls_list_add(nls_node *ent, nls_node *item);
 void nls_list_remove(nls_node **ent);
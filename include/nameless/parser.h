@@ -27,6 +27,14 @@ extern FILE *yyout;
 extern int yydebug;
 extern nls_node *nls_sys_parse_result;
 
+/*
+ * Called with each top-level expression as soon as it is parsed, instead
+ * of adding it to nls_sys_parse_result, and given the reference to it.
+ * Nonzero stops parsing.
+ */
+typedef int (*nls_parse_hook)(nls_node *expr);
+extern nls_parse_hook nls_sys_parse_hook;
+
 int yylex(void);
 int yyparse(void);
 
@@ -18,15 +18,22 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <stdint.h>
 
 typedef struct _nls_string {
 	int ns_len;
-	int ns_hash;
-	char *ns_bufp;
+	uint64_t ns_hash;
+	int ns_interned;
+	struct _nls_string *ns_next; /* Intern table chain */
+	char ns_buf[];
 } nls_string;
 
 nls_string* nls_string_new(char *s);
+nls_string* nls_string_intern(char *s);
+void nls_string_table_init(void);
+void nls_string_table_term(void);
 void nls_string_free(void *ptr);
+void nls_string_trace(void *ptr);
 int nls_strcmp(nls_string *s1, nls_string *s2);
 
 #endif /* _NAMELESS_STRING_H_ */
@@ -0,0 +1 @@
+#include "/tmp/lexstub/scan_stub.c"
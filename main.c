@@ -16,10 +16,117 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <getopt.h>
 #include "nameless.h"
 
+static const char *nls_eval_names[] = {
+	[NLS_EVAL_SUBST]   = "subst",
+	[NLS_EVAL_ENV]     = "env",
+	[NLS_EVAL_VM]      = "vm",
+	[NLS_EVAL_CLOSURE] = "closure",
+};
+
+static const struct option nls_long_opts[] = {
+	{"emit-c", no_argument, NULL, 'c'},
+	{NULL, 0, NULL, 0},
+};
+
+static int nls_eval_mode_get(char *name);
+static void nls_usage(char *prog);
+
 int
 main(int argc, char *argv[])
 {
+	int opt, eval;
+
+	while (-1 != (opt = getopt_long(argc, argv, "ab:de:fil:m:n:st:",
+		nls_long_opts, NULL))) {
+		switch (opt) {
+		case 'a':
+			nls_sys_config.nc_arena = 1;
+			break;
+		case 'b':
+			nls_sys_config.nc_free_budget = atoi(optarg);
+			break;
+		case 'c':
+			nls_sys_config.nc_emit_c = 1;
+			break;
+		case 'd':
+			nls_sys_config.nc_deferred = 1;
+			break;
+		case 'e':
+			if (0 > (eval = nls_eval_mode_get(optarg))) {
+				nls_usage(argv[0]);
+				return 1;
+			}
+			nls_sys_config.nc_eval = eval;
+			break;
+		case 'f':
+			nls_sys_config.nc_fold = 1;
+			break;
+		case 'i':
+			nls_sys_config.nc_intern = 1;
+			break;
+		case 'l':
+			nls_sys_config.nc_inline_size = atoi(optarg);
+			nls_sys_config.nc_fold = 1;
+			break;
+		case 'm':
+			nls_sys_config.nc_max_depth = atoi(optarg);
+			break;
+		case 'n':
+			nls_sys_config.nc_nursery_size = atoi(optarg);
+			break;
+		case 's':
+			nls_sys_config.nc_stats = 1;
+			break;
+		case 't':
+			nls_sys_config.nc_tier_threshold = atoi(optarg);
+			break;
+		default:
+			nls_usage(argv[0]);
+			return 1;
+		}
+	}
+	if (nls_sys_config.nc_intern && NLS_EVAL_SUBST == nls_sys_config.nc_eval) {
+		/* Substitution rewrites terms in place, so none can be shared. */
+		nls_usage(argv[0]);
+		return 1;
+	}
 	return nls_main(stdin, stdout, stderr);
 }
+
+static int
+nls_eval_mode_get(char *name)
+{
+	int i;
+
+	for (i = 0; i < sizeof(nls_eval_names) / sizeof(char*); i++) {
+		if (!strcmp(name, nls_eval_names[i])) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+static void
+nls_usage(char *prog)
+{
+	fprintf(stderr, "usage: %s [-adfis] [-b budget] [-e eval] [-l size] [-m depth]\n"
+		"       [-n size] [-t calls] [--emit-c]\n", prog);
+	fprintf(stderr, "  -a  Allocate each top-level expression from an arena\n");
+	fprintf(stderr, "  -b  Free at most budget objects per release/allocation\n");
+	fprintf(stderr, "  -d  Defer freeing to safe points\n");
+	fprintf(stderr, "  -e  Evaluator: subst (default), env, vm or closure\n");
+	fprintf(stderr, "  -f  Fold calls of builtins and literal lambdas on ints\n");
+	fprintf(stderr, "  -i  Share equal ints, variables and lists (not with subst)\n");
+	fprintf(stderr, "  -l  Inline calls of globals of at most size nodes, as -f\n");
+	fprintf(stderr, "  -m  Fail reductions nested deeper than depth (at most 4096 but for subst)\n");
+	fprintf(stderr, "  -n  Collect after size bytes of allocation (GC build)\n");
+	fprintf(stderr, "  -s  Print memory statistics and calls of globals on exit\n");
+	fprintf(stderr, "  -t  Compile a global once it has been called calls times (subst)\n");
+	fprintf(stderr, "  --emit-c  Write the program as C, to link with libnameless.a\n");
+}
@@ -0,0 +1,270 @@
+/*
+ * Nameless - A lambda calculation language.
+ * Copyright (C) 2009 Yoshifumi Shimono <yoshifumi.shimono@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include "nameless.h"
+#include "nameless/node.h"
+#include "nameless/mm.h"
+
+#define NLS_MEMO_SIZE     4096 /* Entries, a power of 2 */
+#define NLS_MEMO_MAX_ARGS 4
+
+/*
+ * Results of memoized abstractions (see memo()), keyed by the definition
+ * and the values of the arguments. Only ints are memoized, as arguments
+ * and as results, so an entry holds no node but the definition.
+ *
+ * The table has a fixed number of entries, chained in buckets by hash.
+ * When it is full, a CLOCK hand evicts the first entry not used since
+ * the hand last passed it. Setting any global may change what a
+ * definition computes, so it starts a new generation and the entries of
+ * older ones never hit again.
+ */
+typedef struct _nls_memo_key {
+	nls_node *nmk_def;
+	unsigned long nmk_gen;
+	uint32_t nmk_hash;
+	int nmk_num_args;
+	int nmk_args[NLS_MEMO_MAX_ARGS];
+} nls_memo_key;
+
+typedef struct _nls_memo_entry {
+	nls_memo_key nme_key; /* nmk_def is NULL if free */
+	int nme_value;
+	int nme_used; /* Hit since the hand last passed */
+	int nme_next; /* In the bucket, -1 at the end */
+} nls_memo_entry;
+
+static nls_memo_entry nls_memo_table[NLS_MEMO_SIZE];
+static int nls_memo_buckets[NLS_MEMO_SIZE];
+static int nls_memo_num;
+static int nls_memo_hand;
+static unsigned long nls_memo_gen;
+static unsigned long nls_memo_hits;
+static unsigned long nls_memo_misses;
+static unsigned long nls_memo_evictions;
+
+static nls_memo_entry* nls_memo_search(nls_memo_key *key);
+static int nls_memo_victim(void);
+static void nls_memo_unlink(int i);
+static int nls_memo_same(nls_memo_key *key1, nls_memo_key *key2);
+
+/**
+ * Look up an application of the definition def to args, which are
+ * reduced already.
+ * @param  def  Abstraction applied.
+ * @param  args Arguments.
+ * @param  out  Result, if found.
+ * @param  key  Key to store the result with by nls_memo_store(), if not
+ *              found; NULL if the application is not memoized.
+ * @retval 0    Found or not.
+ * @retval else Error code.
+ */
+int
+nls_memo_find(nls_node *def, nls_node *args, nls_node **out, nls_memo_key **key)
+{
+	int i = 0;
+	uint64_t hash = (uintptr_t)def;
+	nls_node **item, *tmp;
+	nls_memo_key probe;
+	nls_memo_entry *ent;
+
+	*out = NULL;
+	*key = NULL;
+	nls_list_foreach(args, &item, &tmp) {
+		if (NLS_MEMO_MAX_ARGS <= i || !NLS_ISINT(*item)) {
+			return 0;
+		}
+		probe.nmk_args[i++] = NLS_INT_VAL(*item);
+		hash = hash * 0x100000001b3ULL + (uint32_t)NLS_INT_VAL(*item);
+	}
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	probe.nmk_def = def;
+	probe.nmk_gen = nls_memo_gen;
+	probe.nmk_hash = (uint32_t)hash;
+	probe.nmk_num_args = i;
+	if ((ent = nls_memo_search(&probe))) {
+		nls_memo_hits++;
+		ent->nme_used = 1;
+		return (*out = nls_int_new(ent->nme_value)) ? 0 : ENOMEM;
+	}
+	nls_memo_misses++;
+	if (!(*key = malloc(sizeof(nls_memo_key)))) {
+		return ENOMEM;
+	}
+	**key = probe;
+	return 0;
+}
+
+/**
+ * Store the result of an application looked up by nls_memo_find(), and
+ * free its key. Only an int is stored, and only if no global has been
+ * set since the lookup.
+ */
+void
+nls_memo_store(nls_memo_key *key, nls_node *value)
+{
+	int i;
+	nls_memo_entry *ent;
+
+	if (NLS_ISINT(value) && key->nmk_gen == nls_memo_gen &&
+		!nls_memo_search(key)) {
+		if (nls_memo_num < NLS_MEMO_SIZE) {
+			if (!nls_memo_num) {
+				for (i = 0; i < NLS_MEMO_SIZE; i++) {
+					nls_memo_buckets[i] = -1;
+				}
+			}
+			i = nls_memo_num++;
+		} else {
+			i = nls_memo_victim();
+		}
+		ent = &nls_memo_table[i];
+		ent->nme_key = *key;
+		ent->nme_key.nmk_def = nls_grab(key->nmk_def);
+		ent->nme_value = NLS_INT_VAL(value);
+		ent->nme_used = 0;
+		ent->nme_next = nls_memo_buckets[key->nmk_hash & (NLS_MEMO_SIZE - 1)];
+		nls_memo_buckets[key->nmk_hash & (NLS_MEMO_SIZE - 1)] = i;
+	}
+	free(key);
+}
+
+/**
+ * A global has been set: forget every result so far.
+ */
+void
+nls_memo_invalidate(void)
+{
+	nls_memo_gen++;
+}
+
+/**
+ * Called at safe points, where the collector may run.
+ */
+void
+nls_memo_safepoint(void)
+{
+#ifdef NLS_GC
+	/*
+	 * A collection moves the definitions the entries refer to, and
+	 * those of the keys still waiting for a result: drop both.
+	 */
+	nls_memo_term();
+	nls_memo_invalidate();
+#endif /* NLS_GC */
+}
+
+void
+nls_memo_term(void)
+{
+	int i;
+
+	for (i = 0; i < nls_memo_num; i++) {
+		nls_release(nls_memo_table[i].nme_key.nmk_def);
+	}
+	nls_memo_num = 0;
+	nls_memo_hand = 0;
+}
+
+void
+nls_memo_stat_print(FILE *out)
+{
+	if (!nls_memo_hits && !nls_memo_misses) {
+		return;
+	}
+	fprintf(out, "memo hits: %lu\n", nls_memo_hits);
+	fprintf(out, "memo misses: %lu\n", nls_memo_misses);
+	fprintf(out, "memo evictions: %lu\n", nls_memo_evictions);
+}
+
+static nls_memo_entry*
+nls_memo_search(nls_memo_key *key)
+{
+	int i;
+
+	if (!nls_memo_num) {
+		return NULL;
+	}
+	for (i = nls_memo_buckets[key->nmk_hash & (NLS_MEMO_SIZE - 1)];
+		0 <= i; i = nls_memo_table[i].nme_next) {
+		if (nls_memo_same(&nls_memo_table[i].nme_key, key)) {
+			return &nls_memo_table[i];
+		}
+	}
+	return NULL;
+}
+
+/*
+ * Evict an entry by CLOCK, and return its index. Entries of an older
+ * generation go first.
+ */
+static int
+nls_memo_victim(void)
+{
+	int i;
+	nls_memo_entry *ent;
+
+	for (;;) {
+		i = nls_memo_hand;
+		nls_memo_hand = (nls_memo_hand + 1) & (NLS_MEMO_SIZE - 1);
+		ent = &nls_memo_table[i];
+		if (ent->nme_used && ent->nme_key.nmk_gen == nls_memo_gen) {
+			ent->nme_used = 0;
+			continue;
+		}
+		nls_memo_evictions++;
+		nls_memo_unlink(i);
+		nls_release(ent->nme_key.nmk_def);
+		return i;
+	}
+}
+
+static void
+nls_memo_unlink(int i)
+{
+	int *link = &nls_memo_buckets[nls_memo_table[i].nme_key.nmk_hash &
+		(NLS_MEMO_SIZE - 1)];
+
+	while (*link != i) {
+		link = &nls_memo_table[*link].nme_next;
+	}
+	*link = nls_memo_table[i].nme_next;
+}
+
+static int
+nls_memo_same(nls_memo_key *key1, nls_memo_key *key2)
+{
+	int i;
+
+	if (key1->nmk_hash != key2->nmk_hash || key1->nmk_def != key2->nmk_def ||
+		key1->nmk_gen != key2->nmk_gen ||
+		key1->nmk_num_args != key2->nmk_num_args) {
+		return 0;
+	}
+	for (i = 0; i < key1->nmk_num_args; i++) {
+		if (key1->nmk_args[i] != key2->nmk_args[i]) {
+			return 0;
+		}
+	}
+	return 1;
+}
@@ -16,7 +16,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <stdlib.h>
+#include <string.h>
 #include <errno.h>
+#include <sys/resource.h>
 #include "nameless.h"
 #include "nameless/mm.h"
 
@@ -27,6 +29,92 @@
 #define NLS_MSG_GRAB_NULL    "Grabbing NULL pointer"
 #define NLS_MSG_RELEASE_NULL "Releasing NULL pointer"
 #define NLS_MSG_FREE_NULL    "Freeing NULL pointer"
+#define NLS_MSG_TOO_MANY_OPS "Too many free operations"
+#define NLS_MSG_ARENA_ESCAPED "Arena object still referenced"
+#define NLS_MSG_TOO_MANY_ROOTS "Too many GC roots"
+
+/*
+ * Chunks up to NLS_MEM_NUM_CLASSES * NLS_MEM_ALIGN bytes (header included)
+ * are carved out of NLS_MEM_SLAB_SIZE slabs and recycled through per-class
+ * free lists. Larger chunks go straight to malloc().
+ */
+#define NLS_MEM_ALIGN       16
+#define NLS_MEM_NUM_CLASSES 16
+#define NLS_MEM_SLAB_SIZE   (64 * 1024)
+
+#define NLS_MEM_CLASS(size) \
+	(((size) + sizeof(nls_mem) + NLS_MEM_ALIGN - 1) / NLS_MEM_ALIGN - 1)
+#define NLS_MEM_CLASS_SIZE(class) (((class) + 1) * NLS_MEM_ALIGN)
+#define NLS_MEM_ROUNDUP(size) \
+	(((size) + NLS_MEM_ALIGN - 1) & ~((size_t)NLS_MEM_ALIGN - 1))
+
+/*
+ * While an arena is active, allocations are bumped out of
+ * NLS_MEM_REGION_BLOCK_SIZE blocks and freeing them only updates counters.
+ * The blocks are rewound at once by nls_arena_end().
+ */
+#define NLS_MEM_REGION_BLOCK_SIZE (64 * 1024)
+
+/*
+ * Objects whose reference count dropped to zero wait in a FIFO queue
+ * instead of being freed recursively, so that dropping a long list or a
+ * deep tree needs no C stack. With a free budget set, at most that many
+ * objects are freed per release/allocation and the rest is carried over.
+ */
+#define NLS_MEM_PENDING_INIT_SIZE 256
+
+/*
+ * In deferred mode, objects whose reference count dropped to zero are
+ * only recorded in the zero count table (ZCT). Nothing is freed until
+ * the next safe point, so the evaluator may hold borrowed pointers in
+ * C locals without counting them. Entries grabbed again in the meantime
+ * are simply dropped from the table. Besides the end of each top-level
+ * expression, the reduction loop takes a safe point once the table has
+ * NLS_MEM_ZCT_LIMIT entries.
+ */
+#define NLS_MEM_ZCT_LIMIT 4096
+
+/*
+ * GC builds bump new objects out of a nursery made of
+ * NLS_MEM_REGION_BLOCK_SIZE blocks. Once nls_gc_nursery_size bytes were
+ * allocated, the next safe point copies the reachable nursery objects
+ * into the old space (slab chunks on the memchain) and rewinds the
+ * nursery. A minor collection scans the roots and the remembered set
+ * only: an old object a pointer is stored in must be passed to the write
+ * barrier nls_gc_write(), which remembers it until the next minor
+ * collection. When the old space outgrows nls_gc_old_limit, a major
+ * collection marks from the roots and sweeps the memchain.
+ */
+#define NLS_GC_NURSERY_SIZE (4 * 1024 * 1024)
+#define NLS_GC_MAX_ROOTS    8
+#define NLS_MEM_VEC_INIT_SIZE 256
+
+#define NLS_MEM_GC_OLD       0x1
+#define NLS_MEM_GC_MARK      0x2
+#define NLS_MEM_GC_FORWARDED 0x4
+#define NLS_MEM_GC_REMEMBERED 0x8
+
+#define NLS_GC_MINOR 1
+#define NLS_GC_MAJOR 2
+
+#ifdef NLS_RELEASE
+# define NLS_MEM_NUM_OPS 16
+# define NLS_MEM_CLASS_LARGE (NLS_MEM_NUM_CLASSES)
+# define NLS_MEM_CLASS_ARENA (NLS_MEM_NUM_CLASSES + 1)
+# define NLS_MEM_CHUNK_CLASS(mem) ((mem)->nm_class)
+# define NLS_MEM_FREE_OP(mem) (nls_mem_ops[(mem)->nm_op].nmo_free_op)
+# define NLS_MEM_IS_ARENA(mem) (NLS_MEM_CLASS_ARENA == (mem)->nm_class)
+#elif defined(NLS_GC)
+# define NLS_MEM_CHUNK_CLASS(mem) NLS_MEM_CLASS((mem)->nm_size)
+# define NLS_MEM_FREE_OP(mem) ((mem)->nm_trace_op)
+# define NLS_MEM_IS_ARENA(mem) 0
+#else
+# define NLS_MEM_CHUNK_CLASS(mem) NLS_MEM_CLASS((mem)->nm_size)
+# define NLS_MEM_FREE_OP(mem) ((mem)->nm_free_op)
+# define NLS_MEM_IS_ARENA(mem) (NLS_MAGIC_ARENACHUNK == (mem)->nm_magic)
+# define NLS_MEM_IS_VALID(mem) \
+	((NLS_MAGIC_MEMCHUNK == (mem)->nm_magic) || NLS_MEM_IS_ARENA(mem))
+#endif /* NLS_RELEASE */
 
 #define nls_mem_chain_foreach_safe(item, tmp) \
 	for (*(item) = nls_mem_chain.nm_next, \
@@ -35,23 +123,137 @@
 		*(item) = *(tmp), \
 		*(tmp) = (*(tmp))->nm_next)
 
-static int nls_mem_alloc_cnt;
-static int nls_mem_free_cnt;
+typedef struct _nls_mem_slab {
+	struct _nls_mem_slab *nms_next;
+} nls_mem_slab;
+
+/* A chunk sitting on a free list. Overlays the header of the chunk. */
+typedef struct _nls_mem_free_chunk {
+	struct _nls_mem_free_chunk *nmf_next;
+} nls_mem_free_chunk;
+
+/* Blocks of bump allocation, shared by the arena and the GC nursery. */
+typedef struct _nls_mem_region {
+	nls_mem_slab *nmr_blocks;
+	nls_mem_slab *nmr_block;
+	char *nmr_top;
+	char *nmr_end;
+} nls_mem_region;
+
+typedef struct _nls_mem_vec {
+	void **nmv_items;
+	size_t nmv_num;
+	size_t nmv_size;
+} nls_mem_vec;
+
+typedef struct _nls_mem_op {
+	nls_free_op nmo_free_op;
+	const char *nmo_type;
+} nls_mem_op;
+
+static unsigned long nls_mem_alloc_cnt;
+static unsigned long nls_mem_free_cnt;
+static unsigned long nls_mem_grab_cnt;
+static unsigned long nls_mem_release_cnt;
+static unsigned long nls_mem_zct_cnt;
+static nls_mem_slab *nls_mem_slabs;
+static nls_mem_free_chunk *nls_mem_free_list[NLS_MEM_NUM_CLASSES];
+
+static void **nls_mem_pending;
+static size_t nls_mem_pending_size;
+static size_t nls_mem_pending_head;
+static size_t nls_mem_pending_num;
+static int nls_mem_freeing;
+static int nls_mem_free_budget;
+static int nls_mem_deferred;
+static nls_mem_vec nls_mem_zct;
+
+static int nls_mem_arena_on;
+static int nls_mem_arena_suspended;
+static unsigned long nls_mem_arena_live;
+static nls_mem_region nls_mem_arena;
+#ifdef NLS_GC
+static nls_mem_region nls_gc_nursery;
+static size_t nls_gc_nursery_size = NLS_GC_NURSERY_SIZE;
+static size_t nls_gc_nursery_used;
+static unsigned long nls_gc_nursery_cnt;
+static size_t nls_gc_old_size;
+static size_t nls_gc_old_limit;
+static int nls_gc_phase;
+static int nls_gc_num_roots;
+static nls_gc_root_op nls_gc_roots[NLS_GC_MAX_ROOTS];
+static nls_mem_vec nls_gc_root_stack;
+static nls_mem_vec nls_gc_marks;     /* Mark stack */
+static nls_mem_vec nls_gc_remembered; /* Old objects written to */
+static unsigned long nls_gc_moved_cnt; /* Nursery objects promoted */
+static unsigned long nls_gc_minor_cnt;
+static unsigned long nls_gc_major_cnt;
+static unsigned long nls_gc_remembered_cnt;
+static size_t nls_gc_promoted;
+#endif /* NLS_GC */
+#ifdef NLS_RELEASE
+static int nls_mem_num_ops;
+static nls_mem_op nls_mem_ops[NLS_MEM_NUM_OPS];
+
+static int nls_mem_op_index(nls_free_op free_op, const char *type);
+#else
 static nls_mem nls_mem_chain;
 
 static void nls_mem_chain_add(nls_mem *mem);
 static void nls_mem_chain_remove(nls_mem *mem);
+#endif /* NLS_RELEASE */
+static nls_mem* nls_mem_chunk_alloc(size_t size);
+static void nls_mem_chunk_free(nls_mem *mem);
+static int nls_mem_slab_grow(int class);
+static void nls_mem_slab_term(void);
+#ifndef NLS_GC
+static int nls_mem_pending_push(void *ptr);
+#endif /* !NLS_GC */
+static void nls_mem_free_pending(int budget);
+static void nls_mem_pending_term(void);
+static int nls_mem_vec_push(nls_mem_vec *vec, void *item);
+static void nls_mem_vec_term(nls_mem_vec *vec);
+#ifndef NLS_GC
+static void nls_mem_zct_reconcile(void);
+#endif /* !NLS_GC */
+static nls_mem* nls_mem_region_alloc(nls_mem_region *region, size_t size);
+static void nls_mem_region_rewind(nls_mem_region *region);
+static void nls_mem_region_term(nls_mem_region *region);
+#ifdef NLS_GC
+static void nls_gc_init(void);
+static void nls_gc_term(void);
+static void* nls_gc_alloc(size_t size, nls_free_op trace_op);
+static void nls_gc_push(nls_mem_vec *vec, void *item);
+static void nls_gc_visit_roots(void);
+static void nls_gc_evacuate(nls_mem *mem);
+static void nls_gc_minor(void);
+static void nls_gc_major(void);
+#endif /* NLS_GC */
 
 int
 nls_mem_chain_init(void)
 {
 	nls_mem_alloc_cnt = 0;
 	nls_mem_free_cnt  = 0;
+	nls_mem_grab_cnt  = 0;
+	nls_mem_release_cnt = 0;
+	nls_mem_zct_cnt = 0;
+	nls_mem_free_budget = 0;
+	nls_mem_deferred = 0;
+	nls_mem_arena_on = 0;
+	nls_mem_arena_suspended = 0;
+	nls_mem_arena_live = 0;
 
+#ifndef NLS_RELEASE
 	nls_mem_chain.nm_next = &nls_mem_chain;
 	nls_mem_chain.nm_prev = &nls_mem_chain;
-	nls_mem_chain.nm_ref  = 1;
 	nls_mem_chain.nm_size = 0;
+#endif /* !NLS_RELEASE */
+#ifdef NLS_GC
+	nls_gc_init();
+#elif !defined(NLS_RELEASE)
+	nls_mem_chain.nm_ref  = 1;
+#endif /* NLS_GC */
 
 	return 0;
 }
@@ -59,14 +261,21 @@ nls_mem_chain_init(void)
 void
 nls_mem_chain_term(void)
 {
+#if !defined(NLS_RELEASE) && !defined(NLS_GC)
 	nls_mem *item, *tmp;
+#endif /* !NLS_RELEASE && !NLS_GC */
 
+#ifdef NLS_GC
+	nls_gc_term();
+#else
+	nls_mem_flush();
 	if (nls_mem_alloc_cnt != nls_mem_free_cnt) {
-		NLS_WARN(NLS_MSG_ILLEGAL_ALLOCCNT ": alloc=%d free=%d",
+		NLS_WARN(NLS_MSG_ILLEGAL_ALLOCCNT ": alloc=%lu free=%lu",
 			nls_mem_alloc_cnt, nls_mem_free_cnt);
 	}
+#ifndef NLS_RELEASE
 	nls_mem_chain_foreach_safe(&item, &tmp) {
-		if (NLS_MAGIC_MEMCHUNK != item->nm_magic) {
+		if (!NLS_MEM_IS_VALID(item)) {
 			NLS_BUG(NLS_MSG_BROKEN_MEMCHAIN);
 			return;
 		}
@@ -76,22 +285,55 @@ nls_mem_chain_term(void)
 				item, (item + 1), item->nm_ref, item->nm_size,
 				item->nm_type);
 		}
-		free(item);
+		nls_mem_chunk_free(item);
 	}
+#endif /* !NLS_RELEASE */
+#endif /* NLS_GC */
+	nls_mem_pending_term();
+	nls_mem_vec_term(&nls_mem_zct);
+	nls_mem_region_term(&nls_mem_arena);
+	nls_mem_slab_term();
 }
 
 void*
 nls_grab(void *ptr)
 {
+#ifdef NLS_GC
+	return ptr;
+#else
 	nls_mem *mem;
 
+	if (NLS_MEM_IS_IMMEDIATE(ptr)) {
+		return ptr;
+	}
+#ifndef NLS_RELEASE
 	if (!ptr) {
 		NLS_BUG(NLS_MSG_GRAB_NULL);
 		return NULL;
 	}
+#endif /* !NLS_RELEASE */
 	mem = (nls_mem*)(ptr - sizeof(nls_mem));
 	mem->nm_ref++;
+	nls_mem_grab_cnt++;
 	return ptr;
+#endif /* NLS_GC */
+}
+
+/**
+ * Tell if ptr is referenced from a single place, so that the owner of
+ * that reference may overwrite it in place instead of freeing it.
+ */
+int
+nls_is_unique(void *ptr)
+{
+#ifdef NLS_GC
+	return 0; /* No counts to tell. */
+#else
+	if (NLS_MEM_IS_IMMEDIATE(ptr)) {
+		return 0;
+	}
+	return 1 == ((nls_mem*)(ptr - sizeof(nls_mem)))->nm_ref;
+#endif /* NLS_GC */
 }
 
 #ifdef NLS_UNIT_TEST
@@ -103,7 +345,7 @@ test_nls_grab(void)
 	nls_mem *mem;
 	nls_node *node, *ref1, *ref2;
 
-	node = nls_int_new(5);
+	node = nls_int_box(5);
 	mem = (nls_mem*)node - 1;
 	NLS_ASSERT_EQUALS(0, mem->nm_ref);
 
@@ -123,15 +365,23 @@ test_nls_grab(void)
 void
 _nls_release(void *ptr, const char *file, int line, const char *func)
 {
+#ifndef NLS_GC
 	int ref;
 	nls_mem *mem;
 
+	if (NLS_MEM_IS_IMMEDIATE(ptr)) {
+		return;
+	}
+#ifndef NLS_RELEASE
 	if (!ptr) {
 		NLS_BUG(NLS_MSG_RELEASE_NULL);
 		return;
 	}
+#endif /* !NLS_RELEASE */
 	mem = (nls_mem*)(ptr - sizeof(nls_mem));
 	ref = --(mem->nm_ref);
+	nls_mem_release_cnt++;
+#ifndef NLS_RELEASE
 	if (ref < 0) {
 		NLS_BUG(NLS_MSG_INVALID_REFCOUNT "\n"
 			"\tRelease at %s:%d:%s\n"
@@ -140,16 +390,211 @@ _nls_release(void *ptr, const char *file, int line, const char *func)
 			mem->nm_size, mem->nm_type);
 		return;
 	}
-	if (!ref) {
-		(mem->nm_free_op)(ptr);
+#endif /* !NLS_RELEASE */
+	if (ref) {
+		return;
+	}
+	if (nls_mem_deferred && !nls_mem_freeing &&
+		!nls_mem_vec_push(&nls_mem_zct, ptr)) {
+		nls_mem_zct_cnt++;
+		return;
+	}
+	if (nls_mem_pending_push(ptr)) {
+		(NLS_MEM_FREE_OP(mem))(ptr); /* No room to defer it. */
+		return;
+	}
+	if (!nls_mem_freeing) {
+		nls_mem_free_pending(nls_mem_free_budget);
+	}
+#endif /* !NLS_GC */
+}
+
+/**
+ * Limit the number of objects freed by one release or allocation.
+ * @param budget Objects per step, 0 frees everything at once.
+ */
+void
+nls_mem_set_free_budget(int budget)
+{
+	nls_mem_free_budget = budget;
+}
+
+/**
+ * Defer freeing of unreferenced objects to nls_mem_flush().
+ * @param deferred 1: record them in the ZCT, 0: free them right away.
+ */
+void
+nls_mem_set_deferred(int deferred)
+{
+	nls_mem_flush();
+	nls_mem_deferred = deferred;
+}
+
+/**
+ * Free every object left over by an exhausted free budget
+ * or still unreferenced in the ZCT.
+ */
+void
+nls_mem_flush(void)
+{
+#ifndef NLS_GC
+	nls_mem_zct_reconcile();
+#endif /* !NLS_GC */
+	nls_mem_free_pending(0);
+}
+
+/**
+ * Called where no C local holds an object that is not reachable from
+ * the roots. Frees deferred objects, or collects in GC builds.
+ */
+void
+nls_mem_safepoint(void)
+{
+#ifdef NLS_GC
+	if (nls_gc_nursery_used < nls_gc_nursery_size) {
+		return;
+	}
+	nls_gc_minor();
+	if (nls_gc_old_limit < nls_gc_old_size) {
+		nls_gc_major();
 	}
+#else
+	nls_mem_flush();
+#endif /* NLS_GC */
 }
 
+/**
+ * Whether the evaluator should take a safe point between two steps of a
+ * reduction (see nls_mem_safepoint()).
+ */
+int
+nls_mem_safepoint_due(void)
+{
+#ifdef NLS_GC
+	return nls_gc_nursery_used >= nls_gc_nursery_size;
+#else
+	return nls_mem_zct.nmv_num >= NLS_MEM_ZCT_LIMIT;
+#endif /* NLS_GC */
+}
+
+#ifdef NLS_UNIT_TEST
+static void
+test_nls_mem_set_deferred(void)
+{
+	nls_node *node;
+	unsigned long live = nls_mem_alloc_cnt - nls_mem_free_cnt;
+
+	nls_mem_set_deferred(1);
+	node = nls_grab(nls_int_box(1));
+	nls_release(node);
+	NLS_ASSERT_EQUALS(live + 1, nls_mem_alloc_cnt - nls_mem_free_cnt);
+	NLS_ASSERT_NOT(nls_mem_safepoint_due()); /* One entry only */
+
+	nls_grab(node); /* Grabbed again before the safe point */
+	nls_mem_safepoint();
+	NLS_ASSERT_EQUALS(live + 1, nls_mem_alloc_cnt - nls_mem_free_cnt);
+	NLS_ASSERT_EQUALS(1, ((nls_mem*)node - 1)->nm_ref);
+
+	nls_release(node);
+	nls_grab(node);
+	nls_release(node); /* In the ZCT twice */
+	nls_mem_safepoint();
+	NLS_ASSERT_EQUALS(live, nls_mem_alloc_cnt - nls_mem_free_cnt);
+	nls_mem_set_deferred(0);
+}
+#endif /* NLS_UNIT_TEST */
+
+/**
+ * Number of objects allocated and not freed yet.
+ */
+unsigned long
+nls_mem_live(void)
+{
+	return nls_mem_alloc_cnt - nls_mem_free_cnt;
+}
+
+/**
+ * Print allocation counters and the peak resident set size.
+ */
+void
+nls_mem_stat_print(FILE *out)
+{
+	struct rusage usage;
+
+	fprintf(out, "alloc: %lu\n", nls_mem_alloc_cnt);
+	fprintf(out, "free: %lu\n", nls_mem_free_cnt);
+#ifndef NLS_GC
+	fprintf(out, "grab: %lu\n", nls_mem_grab_cnt);
+	fprintf(out, "release: %lu\n", nls_mem_release_cnt);
+	fprintf(out, "deferred: %lu\n", nls_mem_zct_cnt);
+#endif /* !NLS_GC */
+#ifdef NLS_GC
+	fprintf(out, "gc minor: %lu\n", nls_gc_minor_cnt);
+	fprintf(out, "gc major: %lu\n", nls_gc_major_cnt);
+	fprintf(out, "gc promoted: %lu bytes\n", (unsigned long)nls_gc_promoted);
+	fprintf(out, "gc remembered: %lu\n", nls_gc_remembered_cnt);
+#endif /* NLS_GC */
+	if (!getrusage(RUSAGE_SELF, &usage)) {
+		fprintf(out, "peak rss: %ld KB\n", usage.ru_maxrss);
+	}
+}
+
+#ifdef NLS_UNIT_TEST
+static void
+test_nls_release_long_list(void)
+{
+	int i;
+	unsigned long live = nls_mem_alloc_cnt - nls_mem_free_cnt;
+	nls_node *list = nls_grab(nls_list_new(nls_int_new(0)));
+
+	for (i = 1; i < 1000000; i++) {
+		nls_node *cell = nls_list_new(nls_int_new(i));
+
+		cell->nn_list.nl_rest = list; /* Takes over the reference. */
+		list = nls_grab(cell);
+	}
+	nls_release(list); /* Must not exhaust the C stack. */
+	NLS_ASSERT_EQUALS(live, nls_mem_alloc_cnt - nls_mem_free_cnt);
+}
+
+static void
+test_nls_release_with_budget(void)
+{
+	int i;
+	nls_node *node;
+	unsigned long live = nls_mem_alloc_cnt - nls_mem_free_cnt;
+	nls_node *list = nls_grab(nls_list_new(nls_int_box(0)));
+
+	for (i = 1; i < 100; i++) {
+		nls_list_add(list, nls_int_box(i));
+	}
+	nls_mem_set_free_budget(10);
+	nls_release(list);
+	NLS_ASSERT_NOT_EQUALS(0, nls_mem_pending_num);
+
+	NLS_ASSERT_EQUALS(live + 200 - 10, nls_mem_alloc_cnt - nls_mem_free_cnt);
+
+	node = nls_grab(nls_int_box(0)); /* Frees another 10 first. */
+	NLS_ASSERT_EQUALS(live + 200 - 20 + 1,
+		nls_mem_alloc_cnt - nls_mem_free_cnt);
+	nls_release(node);
+
+	nls_mem_flush();
+	NLS_ASSERT_EQUALS(0, nls_mem_pending_num);
+	NLS_ASSERT_EQUALS(live, nls_mem_alloc_cnt - nls_mem_free_cnt);
+	nls_mem_set_free_budget(0);
+}
+#endif /* NLS_UNIT_TEST */
+
 void
 _nls_free(void *ptr, const char *file, int line, const char *func)
 {
+#ifndef NLS_GC
 	nls_mem *mem;
 
+#ifdef NLS_RELEASE
+	mem = (nls_mem*)(ptr - sizeof(nls_mem));
+#else
 	if (!ptr) {
 		NLS_BUG(NLS_MSG_FREE_NULL);
 		return;
@@ -159,7 +604,7 @@ _nls_free(void *ptr, const char *file, int line, const char *func)
 		NLS_BUG(NLS_MSG_ILLEGAL_MEMCHAIN_OPERATION);
 		return;
 	}
-	if (NLS_MAGIC_MEMCHUNK != mem->nm_magic) {
+	if (!NLS_MEM_IS_VALID(mem)) {
 		NLS_ERROR(NLS_MSG_BROKEN_MEMCHAIN);
 		return;
 	}
@@ -172,9 +617,11 @@ _nls_free(void *ptr, const char *file, int line, const char *func)
 			mem->nm_size, mem->nm_type);
 		return;
 	}
-	nls_mem_free_cnt++;
 	nls_mem_chain_remove(mem);
-	free(mem);
+#endif /* NLS_RELEASE */
+	nls_mem_free_cnt++;
+	nls_mem_chunk_free(mem);
+#endif /* !NLS_GC */
 }
 
 void
@@ -183,6 +630,14 @@ nls_array_free(void *ptr)
 	nls_free(ptr);
 }
 
+#ifdef NLS_GC
+void
+nls_array_trace(void *ptr)
+{
+	/* Arrays hold no managed pointers. */
+}
+#endif /* NLS_GC */
+
 /*
  * Allocate memory & add to memchain
  *
@@ -192,20 +647,46 @@ nls_array_free(void *ptr)
 void*
 _nls_malloc(size_t size, const char *type, nls_free_op free_op)
 {
-	nls_mem *mem = malloc(size + sizeof(nls_mem));
+#ifdef NLS_GC
+	return nls_gc_alloc(size, free_op);
+#else
+	nls_mem *mem = NULL;
+	int arena = nls_mem_arena_on && !nls_mem_arena_suspended;
 
-	if (!mem) {
+	if (nls_mem_pending_num && !nls_mem_freeing) {
+		nls_mem_free_pending(nls_mem_free_budget);
+	}
+	if (arena) {
+		if ((mem = nls_mem_region_alloc(&nls_mem_arena, size))) {
+			nls_mem_arena_live++;
+		} else {
+			arena = 0; /* Too large for a block: use the heap. */
+		}
+	}
+	if (!mem && !(mem = nls_mem_chunk_alloc(size))) {
 		return NULL;
 	}
 	nls_mem_alloc_cnt++;
-	mem->nm_magic = NLS_MAGIC_MEMCHUNK;
-	mem->nm_type = type;
 	mem->nm_ref  = 0;
+#ifdef NLS_RELEASE
+	if (arena) {
+		mem->nm_class = NLS_MEM_CLASS_ARENA;
+	} else if (NLS_MEM_CLASS(size) < NLS_MEM_NUM_CLASSES) {
+		mem->nm_class = NLS_MEM_CLASS(size);
+	} else {
+		mem->nm_class = NLS_MEM_CLASS_LARGE;
+	}
+	mem->nm_op = nls_mem_op_index(free_op, type);
+#else
+	mem->nm_magic = arena ? NLS_MAGIC_ARENACHUNK : NLS_MAGIC_MEMCHUNK;
+	mem->nm_type = type;
 	mem->nm_size = size;
 	mem->nm_free_op = free_op;
 	nls_mem_chain_add(mem);
+#endif /* NLS_RELEASE */
 
 	return ++mem;
+#endif /* NLS_GC */
 }
 
 #ifdef NLS_UNIT_TEST
@@ -221,7 +702,7 @@ test_nls_new(void)
 	NLS_ASSERT_EQUALS(&nls_mem_chain, nls_mem_chain.nm_prev);
 	NLS_ASSERT_EQUALS(&nls_mem_chain, nls_mem_chain.nm_next);
 
-	node = nls_grab(nls_int_new(256));
+	node = nls_grab(nls_int_box(256));
 	mem = (nls_mem*)node - 1;
 	NLS_ASSERT_EQUALS(&nls_mem_chain, mem->nm_prev);
 	NLS_ASSERT_EQUALS(&nls_mem_chain, mem->nm_next);
@@ -237,6 +718,30 @@ test_nls_new(void)
 }
 #endif /* NLS_UNIT_TEST */
 
+#ifdef NLS_RELEASE
+/*
+ * Map a free op to its slot in nls_mem_ops, registering it on first use.
+ * Only a handful of object types exist, so a linear scan is enough.
+ */
+static int
+nls_mem_op_index(nls_free_op free_op, const char *type)
+{
+	int i;
+
+	for (i = 0; i < nls_mem_num_ops; i++) {
+		if (nls_mem_ops[i].nmo_free_op == free_op) {
+			return i;
+		}
+	}
+	if (NLS_MEM_NUM_OPS <= nls_mem_num_ops) {
+		NLS_BUG(NLS_MSG_TOO_MANY_OPS);
+		return 0;
+	}
+	nls_mem_ops[i].nmo_free_op = free_op;
+	nls_mem_ops[i].nmo_type = type;
+	return nls_mem_num_ops++;
+}
+#else
 static void
 nls_mem_chain_add(nls_mem *mem)
 {
@@ -264,3 +769,640 @@ nls_mem_chain_remove(nls_mem *mem)
 	mem->nm_next = (nls_mem*)NLS_MAGIC_MEMCHAIN_REMOVED;
 	mem->nm_prev = (nls_mem*)NLS_MAGIC_MEMCHAIN_REMOVED;
 }
+#endif /* NLS_RELEASE */
+
+/*
+ * Get a chunk large enough for nls_mem + size bytes.
+ * Small chunks come from the slab free list of their size class.
+ */
+static nls_mem*
+nls_mem_chunk_alloc(size_t size)
+{
+#ifndef NLS_NO_SLAB
+	nls_mem_free_chunk *chunk;
+	size_t class = NLS_MEM_CLASS(size);
+
+	if (class < NLS_MEM_NUM_CLASSES) {
+		if (!nls_mem_free_list[class] && nls_mem_slab_grow(class)) {
+			return NULL;
+		}
+		chunk = nls_mem_free_list[class];
+		nls_mem_free_list[class] = chunk->nmf_next;
+		return (nls_mem*)chunk;
+	}
+#endif /* !NLS_NO_SLAB */
+	return malloc(size + sizeof(nls_mem));
+}
+
+/*
+ * Give a chunk back. The header must still describe its size class.
+ */
+static void
+nls_mem_chunk_free(nls_mem *mem)
+{
+#ifndef NLS_NO_SLAB
+	size_t class;
+	nls_mem_free_chunk *chunk = (nls_mem_free_chunk*)mem;
+#endif /* !NLS_NO_SLAB */
+
+	if (NLS_MEM_IS_ARENA(mem)) {
+		nls_mem_arena_live--;
+		return;
+	}
+#ifndef NLS_NO_SLAB
+	class = NLS_MEM_CHUNK_CLASS(mem);
+	if (class < NLS_MEM_NUM_CLASSES) {
+		chunk->nmf_next = nls_mem_free_list[class];
+		nls_mem_free_list[class] = chunk;
+		return;
+	}
+#endif /* !NLS_NO_SLAB */
+	free(mem);
+}
+
+#ifdef NLS_UNIT_TEST
+static void
+test_nls_mem_chunk_reuse(void)
+{
+	nls_node *node1, *node2;
+
+	node1 = nls_grab(nls_int_box(1));
+	nls_release(node1);
+	node2 = nls_grab(nls_int_box(2));
+#ifndef NLS_NO_SLAB
+	NLS_ASSERT_EQUALS(node1, node2); /* Recycled from the free list. */
+#endif /* !NLS_NO_SLAB */
+	nls_release(node2);
+}
+#endif /* NLS_UNIT_TEST */
+
+/*
+ * Carve a new slab into chunks of the class and push them on its free list.
+ */
+static int
+nls_mem_slab_grow(int class)
+{
+	char *p, *end;
+	size_t size = NLS_MEM_CLASS_SIZE(class);
+	nls_mem_slab *slab = malloc(NLS_MEM_SLAB_SIZE);
+
+	if (!slab) {
+		return ENOMEM;
+	}
+	slab->nms_next = nls_mem_slabs;
+	nls_mem_slabs = slab;
+
+	end = (char*)slab + NLS_MEM_SLAB_SIZE;
+	for (p = end - size; p >= (char*)slab + NLS_MEM_ALIGN; p -= size) {
+		nls_mem_free_chunk *chunk = (nls_mem_free_chunk*)p;
+
+		chunk->nmf_next = nls_mem_free_list[class];
+		nls_mem_free_list[class] = chunk;
+	}
+	return 0;
+}
+
+static void
+nls_mem_slab_term(void)
+{
+	int i;
+	nls_mem_slab *slab, *next;
+
+	for (slab = nls_mem_slabs; slab; slab = next) {
+		next = slab->nms_next;
+		free(slab);
+	}
+	nls_mem_slabs = NULL;
+	for (i = 0; i < NLS_MEM_NUM_CLASSES; i++) {
+		nls_mem_free_list[i] = NULL;
+	}
+}
+
+/**
+ * Start allocating from the arena.
+ * Everything allocated until nls_arena_end() must be released by then.
+ * Objects meant to outlive it have to be built between
+ * nls_arena_suspend() and nls_arena_resume().
+ */
+void
+nls_arena_begin(void)
+{
+#ifndef NLS_GC
+	nls_mem_arena_on = 1; /* The nursery already plays this part. */
+#endif /* !NLS_GC */
+}
+
+/**
+ * Stop allocating from the arena and rewind all of its blocks.
+ */
+void
+nls_arena_end(void)
+{
+	nls_mem_flush();
+	if (nls_mem_arena_live) {
+		NLS_BUG(NLS_MSG_ARENA_ESCAPED ": live=%lu", nls_mem_arena_live);
+		return;
+	}
+	nls_mem_arena_on = 0;
+	nls_mem_region_rewind(&nls_mem_arena);
+}
+
+int
+nls_arena_active(void)
+{
+	return nls_mem_arena_on && !nls_mem_arena_suspended;
+}
+
+void
+nls_arena_suspend(void)
+{
+	nls_mem_arena_suspended++;
+}
+
+void
+nls_arena_resume(void)
+{
+	nls_mem_arena_suspended--;
+}
+
+#ifdef NLS_UNIT_TEST
+static void
+test_nls_arena(void)
+{
+	nls_node *node1, *node2, *node3;
+
+	nls_arena_begin();
+	node1 = nls_grab(nls_int_box(1));
+	NLS_ASSERT(NLS_MEM_IS_ARENA((nls_mem*)node1 - 1));
+	NLS_ASSERT(nls_arena_active());
+
+	nls_arena_suspend();
+	node2 = nls_grab(nls_int_box(2));
+	NLS_ASSERT_NOT(NLS_MEM_IS_ARENA((nls_mem*)node2 - 1));
+	NLS_ASSERT_NOT(nls_arena_active());
+	nls_arena_resume();
+
+	nls_release(node1);
+	nls_arena_end();
+	NLS_ASSERT_NOT(nls_arena_active());
+
+	nls_arena_begin();
+	node3 = nls_grab(nls_int_box(3));
+	NLS_ASSERT_EQUALS(node1, node3); /* Rewound */
+	nls_release(node3);
+	nls_arena_end();
+
+	nls_release(node2);
+}
+#endif /* NLS_UNIT_TEST */
+
+#ifndef NLS_GC
+static int
+nls_mem_pending_push(void *ptr)
+{
+	size_t i;
+
+	if (nls_mem_pending_num == nls_mem_pending_size) {
+		size_t size = nls_mem_pending_size ?
+			nls_mem_pending_size * 2 : NLS_MEM_PENDING_INIT_SIZE;
+		void **queue = malloc(sizeof(void*) * size);
+
+		if (!queue) {
+			return ENOMEM;
+		}
+		for (i = 0; i < nls_mem_pending_num; i++) {
+			queue[i] = nls_mem_pending[(nls_mem_pending_head + i)
+				% nls_mem_pending_size];
+		}
+		free(nls_mem_pending);
+		nls_mem_pending = queue;
+		nls_mem_pending_size = size;
+		nls_mem_pending_head = 0;
+	}
+	i = (nls_mem_pending_head + nls_mem_pending_num) % nls_mem_pending_size;
+	nls_mem_pending[i] = ptr;
+	nls_mem_pending_num++;
+	return 0;
+}
+#endif /* !NLS_GC */
+
+/*
+ * Run the free ops of queued objects. Releases they make are queued
+ * behind, so the walk is breadth-first and never recurses.
+ */
+static void
+nls_mem_free_pending(int budget)
+{
+	int n;
+
+	if (nls_mem_freeing) {
+		return;
+	}
+	nls_mem_freeing = 1;
+	for (n = 0; nls_mem_pending_num && (!budget || n < budget); n++) {
+		void *ptr = nls_mem_pending[nls_mem_pending_head];
+		nls_mem *mem = (nls_mem*)(ptr - sizeof(nls_mem));
+
+		nls_mem_pending_head =
+			(nls_mem_pending_head + 1) % nls_mem_pending_size;
+		nls_mem_pending_num--;
+		(NLS_MEM_FREE_OP(mem))(ptr);
+	}
+	nls_mem_freeing = 0;
+}
+
+static void
+nls_mem_pending_term(void)
+{
+	free(nls_mem_pending);
+	nls_mem_pending = NULL;
+	nls_mem_pending_size = 0;
+	nls_mem_pending_head = 0;
+	nls_mem_pending_num  = 0;
+}
+
+static int
+nls_mem_vec_push(nls_mem_vec *vec, void *item)
+{
+	if (vec->nmv_num == vec->nmv_size) {
+		size_t size = vec->nmv_size ?
+			vec->nmv_size * 2 : NLS_MEM_VEC_INIT_SIZE;
+		void **items = realloc(vec->nmv_items, sizeof(void*) * size);
+
+		if (!items) {
+			return ENOMEM;
+		}
+		vec->nmv_items = items;
+		vec->nmv_size = size;
+	}
+	vec->nmv_items[vec->nmv_num++] = item;
+	return 0;
+}
+
+static void
+nls_mem_vec_term(nls_mem_vec *vec)
+{
+	free(vec->nmv_items);
+	vec->nmv_items = NULL;
+	vec->nmv_num  = 0;
+	vec->nmv_size = 0;
+}
+
+#ifndef NLS_GC
+/*
+ * Queue the ZCT entries still unreferenced for freeing.
+ * An entry may have been grabbed again, or even dropped to zero twice,
+ * so the survivors are tagged with ref -1 while they are collected.
+ */
+static void
+nls_mem_zct_reconcile(void)
+{
+	size_t i, n = 0;
+	void **items = nls_mem_zct.nmv_items;
+
+	for (i = 0; i < nls_mem_zct.nmv_num; i++) {
+		nls_mem *mem = (nls_mem*)(items[i] - sizeof(nls_mem));
+
+		if (!mem->nm_ref) {
+			mem->nm_ref = -1;
+			items[n++] = items[i];
+		}
+	}
+	nls_mem_zct.nmv_num = 0;
+	for (i = 0; i < n; i++) {
+		nls_mem *mem = (nls_mem*)(items[i] - sizeof(nls_mem));
+
+		mem->nm_ref = 0;
+		if (nls_mem_pending_push(items[i])) {
+			(NLS_MEM_FREE_OP(mem))(items[i]);
+		}
+	}
+}
+#endif /* !NLS_GC */
+
+/*
+ * Bump a chunk out of the region, moving on to its next block (allocated
+ * on demand) when the current one is full.
+ * @return NULL if size does not fit in a block or on malloc() failure.
+ */
+static nls_mem*
+nls_mem_region_alloc(nls_mem_region *region, size_t size)
+{
+	nls_mem *mem;
+	size_t chunk = NLS_MEM_ROUNDUP(size + sizeof(nls_mem));
+
+	if (NLS_MEM_REGION_BLOCK_SIZE - NLS_MEM_ALIGN < chunk) {
+		return NULL;
+	}
+	if (!region->nmr_block ||
+		(size_t)(region->nmr_end - region->nmr_top) < chunk) {
+		nls_mem_slab *next = region->nmr_block ?
+			region->nmr_block->nms_next : region->nmr_blocks;
+
+		if (!next) {
+			if (!(next = malloc(NLS_MEM_REGION_BLOCK_SIZE))) {
+				return NULL;
+			}
+			next->nms_next = NULL;
+			if (region->nmr_block) {
+				region->nmr_block->nms_next = next;
+			} else {
+				region->nmr_blocks = next;
+			}
+		}
+		region->nmr_block = next;
+		region->nmr_top = (char*)next + NLS_MEM_ALIGN;
+		region->nmr_end = (char*)next + NLS_MEM_REGION_BLOCK_SIZE;
+	}
+	mem = (nls_mem*)region->nmr_top;
+	region->nmr_top += chunk;
+	return mem;
+}
+
+/*
+ * Make the next allocation start over from the first block.
+ */
+static void
+nls_mem_region_rewind(nls_mem_region *region)
+{
+	region->nmr_block = NULL;
+	region->nmr_top = NULL;
+	region->nmr_end = NULL;
+}
+
+static void
+nls_mem_region_term(nls_mem_region *region)
+{
+	nls_mem_slab *block, *next;
+
+	for (block = region->nmr_blocks; block; block = next) {
+		next = block->nms_next;
+		free(block);
+	}
+	region->nmr_blocks = NULL;
+	nls_mem_region_rewind(region);
+}
+
+#ifdef NLS_GC
+/**
+ * Register a function visiting a set of root slots with nls_gc_visit().
+ */
+void
+nls_gc_root_add(nls_gc_root_op op)
+{
+	if (NLS_GC_MAX_ROOTS <= nls_gc_num_roots) {
+		NLS_BUG(NLS_MSG_TOO_MANY_ROOTS);
+		return;
+	}
+	nls_gc_roots[nls_gc_num_roots++] = op;
+}
+
+/**
+ * Push a slot (a pointer to an object pointer) on the root stack.
+ */
+void
+nls_gc_root_push(void *slot)
+{
+	nls_gc_push(&nls_gc_root_stack, slot);
+}
+
+void
+nls_gc_root_pop(void)
+{
+	nls_gc_root_stack.nmv_num--;
+}
+
+/**
+ * Write barrier: call with an object after storing a pointer in it,
+ * unless it has just been allocated.
+ */
+void
+nls_gc_write(void *ptr)
+{
+	nls_mem *mem;
+
+	if (!ptr || NLS_MEM_IS_IMMEDIATE(ptr)) {
+		return;
+	}
+	mem = (nls_mem*)(ptr - sizeof(nls_mem));
+	if (NLS_MEM_GC_OLD != (mem->nm_flags &
+			(NLS_MEM_GC_OLD | NLS_MEM_GC_REMEMBERED))) {
+		return; /* Young, or remembered already */
+	}
+	mem->nm_flags |= NLS_MEM_GC_REMEMBERED;
+	nls_gc_push(&nls_gc_remembered, mem);
+	nls_gc_remembered_cnt++;
+}
+
+/**
+ * Set the number of bytes allocated between minor collections.
+ */
+void
+nls_gc_set_nursery_size(size_t size)
+{
+	nls_gc_nursery_size = size ? size : NLS_GC_NURSERY_SIZE;
+	nls_gc_old_limit = 2 * nls_gc_nursery_size;
+}
+
+/**
+ * Trace op callback for a slot holding an object pointer.
+ * Promotes the object in a minor collection, marks it in a major one.
+ */
+void
+nls_gc_visit(void *slot)
+{
+	void **ref = (void**)slot;
+	nls_mem *mem;
+
+	if (!*ref || NLS_MEM_IS_IMMEDIATE(*ref)) {
+		return;
+	}
+	mem = (nls_mem*)(*ref - sizeof(nls_mem));
+	if (NLS_GC_MAJOR == nls_gc_phase) {
+		if (!(mem->nm_flags & NLS_MEM_GC_MARK)) {
+			mem->nm_flags |= NLS_MEM_GC_MARK;
+			nls_gc_push(&nls_gc_marks, mem);
+		}
+		return;
+	}
+	if (mem->nm_flags & NLS_MEM_GC_OLD) {
+		return;
+	}
+	if (!(mem->nm_flags & NLS_MEM_GC_FORWARDED)) {
+		nls_gc_evacuate(mem);
+	}
+	*ref = mem->nm_next + 1;
+}
+
+static void
+nls_gc_init(void)
+{
+	nls_gc_nursery_used = 0;
+	nls_gc_nursery_cnt = 0;
+	nls_gc_moved_cnt = 0;
+	nls_gc_old_size = 0;
+	nls_gc_old_limit = 2 * nls_gc_nursery_size;
+	nls_gc_phase = 0;
+	nls_gc_num_roots = 0;
+	nls_gc_root_stack.nmv_num = 0;
+	nls_gc_minor_cnt = 0;
+	nls_gc_major_cnt = 0;
+	nls_gc_remembered_cnt = 0;
+	nls_gc_promoted = 0;
+}
+
+static void
+nls_gc_term(void)
+{
+	nls_mem *item, *tmp;
+
+	nls_mem_chain_foreach_safe(&item, &tmp) {
+		nls_mem_chain_remove(item);
+		nls_mem_chunk_free(item);
+	}
+	nls_mem_region_term(&nls_gc_nursery);
+	nls_mem_vec_term(&nls_gc_root_stack);
+	nls_mem_vec_term(&nls_gc_marks);
+	nls_mem_vec_term(&nls_gc_remembered);
+}
+
+static void*
+nls_gc_alloc(size_t size, nls_free_op trace_op)
+{
+	nls_mem *mem;
+
+	if ((mem = nls_mem_region_alloc(&nls_gc_nursery, size))) {
+		mem->nm_flags = 0;
+		nls_gc_nursery_used += NLS_MEM_ROUNDUP(size + sizeof(nls_mem));
+		nls_gc_nursery_cnt++;
+	} else if ((mem = nls_mem_chunk_alloc(size))) {
+		/* Too large for a nursery block: allocate it old, and
+		 * remembered, as its fields are stored without a barrier. */
+		mem->nm_flags = NLS_MEM_GC_OLD | NLS_MEM_GC_REMEMBERED;
+		nls_mem_chain_add(mem);
+		nls_gc_push(&nls_gc_remembered, mem);
+		nls_gc_old_size += size;
+	} else {
+		return NULL;
+	}
+	nls_mem_alloc_cnt++;
+	mem->nm_size = size;
+	mem->nm_trace_op = trace_op;
+	return ++mem;
+}
+
+/*
+ * The collector cannot back out of a half done collection,
+ * so running out of memory here is fatal.
+ */
+static void
+nls_gc_push(nls_mem_vec *vec, void *item)
+{
+	if (nls_mem_vec_push(vec, item)) {
+		NLS_ERROR(NLS_MSG_ENOMEM);
+	}
+}
+
+static void
+nls_gc_visit_roots(void)
+{
+	int i;
+	size_t j;
+
+	for (i = 0; i < nls_gc_num_roots; i++) {
+		(nls_gc_roots[i])();
+	}
+	for (j = 0; j < nls_gc_root_stack.nmv_num; j++) {
+		nls_gc_visit(nls_gc_root_stack.nmv_items[j]);
+	}
+}
+
+/*
+ * Copy a nursery object to the tail of the old space and leave
+ * the forwarding address behind.
+ */
+static void
+nls_gc_evacuate(nls_mem *mem)
+{
+	nls_mem *to = nls_mem_chunk_alloc(mem->nm_size);
+
+	if (!to) {
+		NLS_ERROR(NLS_MSG_ENOMEM);
+		return;
+	}
+	memcpy(to, mem, sizeof(nls_mem) + mem->nm_size);
+	to->nm_flags = NLS_MEM_GC_OLD;
+	nls_mem_chain_add(to);
+	nls_gc_old_size += mem->nm_size;
+	nls_gc_promoted += mem->nm_size;
+
+	mem->nm_flags |= NLS_MEM_GC_FORWARDED;
+	mem->nm_next = to;
+	nls_gc_moved_cnt++;
+}
+
+static void
+nls_gc_minor(void)
+{
+	size_t i;
+	nls_mem *item = nls_mem_chain.nm_prev; /* The old space ends here */
+
+	nls_gc_phase = NLS_GC_MINOR;
+	nls_gc_visit_roots();
+	for (i = 0; i < nls_gc_remembered.nmv_num; i++) {
+		nls_mem *mem = nls_gc_remembered.nmv_items[i];
+
+		mem->nm_flags &= ~NLS_MEM_GC_REMEMBERED;
+		(mem->nm_trace_op)(mem + 1);
+	}
+	nls_gc_remembered.nmv_num = 0;
+	/*
+	 * Promoted objects are appended to the memchain,
+	 * so this walk scans them Cheney style.
+	 */
+	for (item = item->nm_next;
+		item != &nls_mem_chain; item = item->nm_next) {
+		(item->nm_trace_op)(item + 1);
+	}
+
+	nls_mem_free_cnt += nls_gc_nursery_cnt - nls_gc_moved_cnt;
+	nls_gc_nursery_cnt = 0;
+	nls_gc_nursery_used = 0;
+	nls_gc_moved_cnt = 0;
+	nls_mem_region_rewind(&nls_gc_nursery);
+	nls_gc_phase = 0;
+	nls_gc_minor_cnt++;
+}
+
+/*
+ * Mark & sweep the old space. The nursery must be empty.
+ */
+static void
+nls_gc_major(void)
+{
+	nls_mem *item, *tmp;
+
+	nls_gc_phase = NLS_GC_MAJOR;
+	nls_gc_visit_roots();
+	while (nls_gc_marks.nmv_num) {
+		item = nls_gc_marks.nmv_items[--nls_gc_marks.nmv_num];
+		(item->nm_trace_op)(item + 1);
+	}
+	nls_mem_chain_foreach_safe(&item, &tmp) {
+		if (item->nm_flags & NLS_MEM_GC_MARK) {
+			item->nm_flags &= ~NLS_MEM_GC_MARK;
+			continue;
+		}
+		nls_gc_old_size -= item->nm_size;
+		nls_mem_chain_remove(item);
+		nls_mem_free_cnt++;
+		nls_mem_chunk_free(item);
+	}
+	nls_gc_old_limit = 2 * nls_gc_old_size;
+	if (nls_gc_old_limit < 2 * nls_gc_nursery_size) {
+		nls_gc_old_limit = 2 * nls_gc_nursery_size;
+	}
+	nls_gc_phase = 0;
+	nls_gc_major_cnt++;
+}
+#endif /* NLS_GC */
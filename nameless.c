@@ -16,8 +16,10 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <stdio.h>
+#include <stdlib.h>
 #include <errno.h>
 #include <string.h>
+#include <unistd.h>
 #include "y.tab.h"
 #include "nameless.h"
 #include "nameless/parser.h"
@@ -26,21 +28,121 @@
 #include "nameless/function.h"
 
 #define NLS_MSG_REDUCTION_FAIL "Reduction failure"
+#define NLS_MSG_TOO_DEEP       "Evaluation too deep"
 
 NLS_GLOBAL FILE *nls_sys_out;
 NLS_GLOBAL FILE *nls_sys_err;
+NLS_GLOBAL nls_config nls_sys_config;
+
+#define NLS_SYM_SLOTS_INIT_SIZE 64
+
+/*
+ * Global definitions live in numbered slots. The symbol table maps each
+ * name to its slot number, and resolved variables index the slots
+ * directly.
+ */
 static nls_hash nls_sym_table;
+static nls_node **nls_sym_slots;
+static int nls_sym_num;
+static int nls_sym_size;
+
+/*
+ * Calls of the abstraction in each slot, for tiered execution: once the
+ * definition of a slot has been called nc_tier_threshold times, it runs
+ * compiled (see nls_symbol_hot()). With nc_fold, also the definition
+ * folded, which full calls copy instead (see nls_symbol_folded()).
+ */
+typedef struct _nls_sym_info {
+	unsigned long nsi_calls; /* Of the current definition */
+	unsigned long nsi_total; /* Of every definition */
+	int nsi_promoted; /* Definitions promoted */
+	int nsi_memo; /* The current definition is memoized (memo()) */
+	nls_node *nsi_folded; /* The current definition folded, or NULL */
+	unsigned long nsi_fold_epoch; /* Of nsi_folded */
+	int nsi_inlined; /* The current definition is inlined somewhere */
+} nls_sym_info;
+
+static nls_sym_info *nls_sym_info_of;
+
+#define NLS_EVAL_STACK_INIT_SIZE 256
+#define NLS_EVAL_MAX_DEPTH (1 << 20) /* Unless nc_max_depth */
+#define NLS_EVAL_MAX_NESTED 4096 /* On the C stack, nc_max_depth or less */
+
+/*
+ * The substitution evaluator keeps the trees being reduced on a stack of
+ * its own, not on the C stack, so a deep reduction fails cleanly at
+ * nc_max_depth instead of crashing. The body of an abstraction applied
+ * is reduced in the entry of the application: tail calls take constant
+ * space.
+ *
+ * In deferred mode (nc_deferred), a builtin global is called straight
+ * from its entry, borrowed without a count instead of being grabbed into
+ * the tree: nothing is freed before the next safe point, where the
+ * entries count their builtins while the ZCT is reconciled.
+ *
+ * In GC builds, the stack is a root. An entry knows the object holding
+ * its tree, to move the slot along with it and to pass it to the write
+ * barrier after storing a reduced tree.
+ */
+typedef enum {
+	NLS_EVAL_START = 0,
+	NLS_EVAL_FUNC_DONE, /* The function applied is reduced */
+	NLS_EVAL_ARGS_DONE, /* The arguments are reduced */
+	NLS_EVAL_MEMO_WAIT, /* The entry above reduces the memoized call */
+} nls_eval_state;
+
+typedef struct _nls_eval_entry {
+	nls_node **nee_tree;
+	nls_node *nee_owner; /* Object holding nee_tree, NULL for a root */
+	nls_eval_state nee_state;
+	struct _nls_memo_key *nee_memo; /* To store the result with */
+	nls_node *nee_func; /* Builtin called, borrowed; or NULL */
+} nls_eval_entry;
+
+/*
+ * Top-level expressions are run one at a time as the parser completes
+ * them (see nls_main_run()), so memory and the latency of the first
+ * result do not grow with the input.
+ */
+static nls_node *nls_main_expr; /* Being run */
+static int nls_main_ret; /* Error it stopped parsing with */
+static int nls_main_flush; /* Print each result at once (a terminal) */
 
+static nls_eval_entry *nls_eval_stack;
+static int nls_eval_sp;
+static int nls_eval_size;
+static int nls_eval_nested; /* Reductions nested on the C stack */
+
+static int nls_eval_top(nls_node **tree);
+static int nls_eval_step(nls_eval_entry *ent);
+static nls_node* nls_eval_builtin(nls_node *func, nls_node *args);
+static int nls_eval_call(nls_node *func, nls_node **tree);
+static void nls_eval_safepoint(void);
+#ifdef NLS_GC
+static void nls_eval_stack_trace(void);
+#endif /* NLS_GC */
+static int nls_eval_push(nls_node **tree, nls_node *owner, nls_eval_state state);
+static void nls_eval_unwind(int base);
+static int nls_eval_memoized(nls_node *func, nls_node *args);
+static int nls_eval_push_args(nls_node *args);
+static int nls_eval_max_depth(void);
 static int nls_apply(nls_node **tree);
+static int nls_main_run(nls_node *expr);
+static void nls_resolve(nls_node *tree);
+static int nls_symbol_slot(nls_string *name);
+static void nls_slot_store(int slot, nls_node *node);
 static void nls_sym_table_init(void);
 static void nls_sym_table_term(void);
+static void nls_sym_calls_print(FILE *out);
+#ifdef NLS_GC
+static void nls_sym_table_trace(void);
+#endif /* NLS_GC */
 
 int
 nls_main(FILE *in, FILE *out, FILE *err)
 {
 	int ret;
 	nls_node *tree;
-	nls_node **item, *tmp;
 
 	yyin  = in;
 	yyout = out;
@@ -48,28 +150,86 @@ nls_main(FILE *in, FILE *out, FILE *err)
 	nls_sys_err = err;
 
 	nls_init(out, err);
-	ret = yyparse();
-	tree = nls_sys_parse_result; /* pointer grabbed in yyparse(). */
-	if (ret || !tree) {
+	nls_main_ret = 0;
+	nls_main_flush = isatty(fileno(in));
+	/* The evaluator state a collection may see between expressions. */
+	nls_gc_root_push(&nls_main_expr);
+	if (!nls_sys_config.nc_emit_c) {
+		/* Run each expression as soon as it is parsed, then drop it. */
+		nls_sys_parse_hook = nls_main_run;
+		ret = yyparse();
+		nls_sys_parse_hook = NULL;
+		if (nls_main_ret) {
+			ret = nls_main_ret;
+		}
 		goto free_exit;
 	}
-	nls_list_foreach(tree, &item, &tmp) {
-		if ((ret = nls_eval(item))) {
-			NLS_ERROR(NLS_MSG_REDUCTION_FAIL ": errno=%d: %s",
-				ret, strerror(ret));
-			goto free_exit;
+	ret = yyparse();
+	tree = nls_sys_parse_result; /* pointer grabbed in yyparse(). */
+	if (!ret) {
+		if (tree) {
+			nls_resolve(tree);
 		}
-		nls_node_print(*item, nls_sys_out);
-		fprintf(out, "\n");
+		ret = nls_emit_c(tree, out);
 	}
-free_exit:
 	if (tree) {
 		nls_release(tree);
 	}
+free_exit:
+	nls_gc_root_pop();
 	nls_term();
 	return ret;
 }
 
+/*
+ * Evaluate and print a top-level expression, as soon as it is parsed,
+ * then drop the reference to it given.
+ * @retval 0    Printed.
+ * @retval else Error code, to stop parsing at.
+ */
+static int
+nls_main_run(nls_node *expr)
+{
+	int ret;
+
+	nls_main_expr = expr;
+	nls_resolve(nls_main_expr);
+	if (nls_sys_config.nc_arena) {
+		nls_arena_begin();
+	}
+	if (nls_sys_config.nc_fold) {
+		nls_fold_scan(nls_main_expr);
+		if ((ret = nls_fold(&nls_main_expr))) {
+			NLS_ERROR(NLS_MSG_ENOMEM);
+			goto error;
+		}
+	}
+	if ((ret = nls_eval_top(&nls_main_expr))) {
+		NLS_ERROR(NLS_MSG_REDUCTION_FAIL ": errno=%d: %s",
+			ret, strerror(ret));
+		goto error;
+	}
+	nls_node_print(nls_main_expr, nls_sys_out);
+	fprintf(nls_sys_out, "\n");
+	if (nls_main_flush) {
+		fflush(nls_sys_out);
+	}
+	nls_release(nls_main_expr);
+	nls_main_expr = NULL;
+	if (nls_sys_config.nc_arena) {
+		nls_arena_end();
+	}
+	nls_node_table_sweep();
+	nls_closure_safepoint();
+	nls_memo_safepoint();
+	nls_mem_safepoint();
+	return 0;
+error:
+	nls_release(nls_main_expr);
+	nls_main_expr = NULL;
+	return nls_main_ret = ret;
+}
+
 void
 nls_init(FILE *out, FILE *err)
 {
@@ -79,14 +239,39 @@ nls_init(FILE *out, FILE *err)
 	nls_sys_out = out;
 	nls_sys_err = err;
 	nls_mem_chain_init();
+	nls_mem_set_free_budget(nls_sys_config.nc_free_budget);
+	nls_mem_set_deferred(nls_sys_config.nc_deferred);
+	nls_gc_set_nursery_size(nls_sys_config.nc_nursery_size);
+	nls_string_table_init();
+	nls_node_table_init();
 	nls_sym_table_init();
+#ifdef NLS_GC
+	nls_gc_root_add(nls_eval_stack_trace);
+#endif /* NLS_GC */
 }
 
 void
 nls_term(void)
 {
+	nls_vm_term();
+	free(nls_eval_stack);
+	nls_eval_stack = NULL;
+	nls_eval_sp = 0;
+	nls_eval_size = 0;
+	if (nls_sys_config.nc_stats) {
+		nls_sym_calls_print(nls_sys_err);
+		nls_memo_stat_print(nls_sys_err);
+	}
+	nls_memo_term();
 	nls_sym_table_term();
+	nls_fold_term();
+	nls_node_table_term();
+	nls_closure_term();
+	nls_string_table_term();
 	nls_mem_chain_term();
+	if (nls_sys_config.nc_stats) {
+		nls_mem_stat_print(nls_sys_err);
+	}
 }
 
 /**
@@ -98,74 +283,703 @@ nls_term(void)
 int
 nls_eval(nls_node **tree)
 {
-	nls_node *out;
+	int ret, base = nls_eval_sp;
+
+	if (NLS_EVAL_SUBST != nls_sys_config.nc_eval) {
+		/* Builtins of the VM evaluate their arguments here too. */
+		return nls_env_eval(tree);
+	}
+	if ((ret = nls_eval_push(tree, NULL, NLS_EVAL_START))) {
+		return ret;
+	}
+	while (base < nls_eval_sp) {
+		if (!base && &nls_main_expr == nls_eval_stack[0].nee_tree
+		    && nls_mem_safepoint_due()) {
+			nls_eval_safepoint();
+		}
+		if ((ret = nls_eval_step(&nls_eval_stack[nls_eval_sp - 1]))) {
+			nls_eval_unwind(base);
+			return ret;
+		}
+	}
+	return 0;
+}
 
+/*
+ * Reduce the tree on top of the stack by one step: push a part of it to
+ * reduce first, reduce it in place, or pop it once it is done.
+ */
+static int
+nls_eval_step(nls_eval_entry *ent)
+{
+	int ret, top = nls_eval_sp - 1;
+	nls_node **tree = ent->nee_tree;
+	nls_node *owner = ent->nee_owner;
+	nls_node *out, *func, *args;
+
+	if (NLS_EVAL_MEMO_WAIT == ent->nee_state) {
+		nls_memo_store(ent->nee_memo, *tree);
+		ent->nee_memo = NULL;
+		nls_eval_sp--;
+		return 0;
+	}
 	if (NLS_ISVAR(*tree)) {
-		if (!(out = nls_symbol_get((*tree)->nn_var.nv_name))) {
+		nls_eval_sp--;
+		if (0 <= (*tree)->nn_var.nv_index) {
+			return 0; /* Bound, but not applied yet. */
+		}
+		if (!(out = nls_symbol_get(*tree))) {
 			return 0;
 		}
+		/* The tree is reduced in place: copy the definition. */
+		if (NLS_TYPE_FUNCTION != NLS_NODE_TYPE(out) &&
+			!(out = nls_node_clone(out))) {
+			return ENOMEM;
+		}
 		nls_release(*tree);
 		*tree = nls_grab(out);
+		nls_gc_write(owner);
 		return 0;
 	}
 	if (!NLS_ISAPP(*tree)) {
+		nls_eval_sp--;
 		return 0;
 	}
-	return nls_apply(tree);
+	func = (*tree)->nn_app.nap_func;
+	args = (*tree)->nn_app.nap_args;
+	switch (ent->nee_state) {
+	case NLS_EVAL_START:
+		if (NLS_ISAPP(func)) {
+			ent->nee_state = NLS_EVAL_FUNC_DONE;
+			return nls_eval_push(&((*tree)->nn_app.nap_func), *tree,
+				NLS_EVAL_START);
+		}
+		if ((ent->nee_func = nls_eval_builtin(func, args))) {
+			func = ent->nee_func;
+		}
+		if (!NLS_ISIMM(func) && NLS_TYPE_FUNCTION == NLS_NODE_TYPE(func) &&
+			func->nn_func.nf_strict &&
+			func->nn_func.nf_num_args == nls_list_count(args)) {
+			/* It reduces them anyway, the first first. */
+			ent->nee_state = NLS_EVAL_ARGS_DONE;
+			return nls_eval_push_args(args);
+		}
+		if (!nls_eval_memoized(func, args)) {
+			break;
+		}
+		/* Arguments not reduced yet are left to the call. */
+		if ((ret = nls_memo_find(nls_symbol_get(func), args, &out,
+			&ent->nee_memo))) {
+			return ret;
+		}
+		if (out) {
+			out = nls_grab(out);
+			nls_release(*tree);
+			*tree = out;
+			nls_gc_write(owner);
+			nls_eval_sp--;
+			return 0;
+		}
+		if (ent->nee_memo) {
+			/* Reduce it above, then store the result. */
+			ent->nee_state = NLS_EVAL_MEMO_WAIT;
+			return nls_eval_push(tree, owner, NLS_EVAL_ARGS_DONE);
+		}
+		break;
+	case NLS_EVAL_FUNC_DONE:
+		if (NLS_ISAPP(func)) {
+			nls_eval_sp--;
+			return 0; /* Irreducible. */
+		}
+		ent->nee_state = NLS_EVAL_START;
+		return 0;
+	default:
+		break;
+	}
+	/* Nested reductions may move the stack: ent is stale after this. */
+	if (ent->nee_func) {
+		ret = nls_eval_call(ent->nee_func, tree);
+	} else {
+		ret = nls_apply(tree);
+	}
+	nls_gc_write(owner);
+	if (NLS_EVAL_AGAIN == ret) {
+		/* A tail call: reduce the result in the same entry. */
+		nls_eval_stack[top].nee_state = NLS_EVAL_START;
+		return 0;
+	}
+	nls_eval_sp--;
+	return ret;
+}
+
+static int
+nls_eval_push(nls_node **tree, nls_node *owner, nls_eval_state state)
+{
+	int size;
+	nls_eval_entry *stack;
+
+	if (nls_eval_sp == nls_eval_size) {
+		if (nls_eval_sp >= nls_eval_max_depth()) {
+			NLS_ERROR(NLS_MSG_TOO_DEEP ": max=%d", nls_eval_max_depth());
+			return EOVERFLOW;
+		}
+		size = nls_eval_size ? 2 * nls_eval_size : NLS_EVAL_STACK_INIT_SIZE;
+		if (size > nls_eval_max_depth()) {
+			size = nls_eval_max_depth();
+		}
+		if (!(stack = realloc(nls_eval_stack, size * sizeof(nls_eval_entry)))) {
+			NLS_ERROR(NLS_MSG_ENOMEM);
+			return ENOMEM;
+		}
+		nls_eval_stack = stack;
+		nls_eval_size = size;
+	}
+	nls_eval_stack[nls_eval_sp].nee_tree = tree;
+	nls_eval_stack[nls_eval_sp].nee_owner = owner;
+	nls_eval_stack[nls_eval_sp].nee_state = state;
+	nls_eval_stack[nls_eval_sp].nee_memo = NULL;
+	nls_eval_stack[nls_eval_sp].nee_func = NULL;
+	nls_eval_sp++;
+	return 0;
+}
+
+/*
+ * Builtin a global applied to all its arguments holds, to borrow in
+ * deferred mode; else NULL. A partial application is left to
+ * nls_var_apply(), as the curried result keeps the builtin.
+ */
+static nls_node*
+nls_eval_builtin(nls_node *func, nls_node *args)
+{
+	nls_node *def;
+
+	if (!nls_sys_config.nc_deferred || !NLS_ISVAR(func) ||
+		!(def = nls_symbol_get(func)) || NLS_ISIMM(def) ||
+		NLS_TYPE_FUNCTION != NLS_NODE_TYPE(def) ||
+		def->nn_func.nf_num_args != nls_list_count(args)) {
+		return NULL;
+	}
+	return def;
+}
+
+/*
+ * Call the builtin func with the arguments of *tree, which the result
+ * replaces. The global applied stays in the tree.
+ */
+static int
+nls_eval_call(nls_node *func, nls_node **tree)
+{
+	int ret;
+	nls_node *out = NULL;
+
+	if ((ret = nls_function_call(func, (*tree)->nn_app.nap_args, &out))) {
+		return ret;
+	}
+	out = nls_grab(out);
+	nls_release(*tree);
+	*tree = out;
+	return 0;
+}
+
+/*
+ * Safe point between two steps of the outermost nls_eval() of
+ * nls_main_expr (not of the folder, whose trees are in C locals): the
+ * trees on the stack hang from nls_main_expr, and only the builtins borrowed
+ * by the entries need counting while unreferenced objects are freed.
+ * A collection may also run here in GC builds.
+ */
+static void
+nls_eval_safepoint(void)
+{
+	int i;
+
+	for (i = 0; i < nls_eval_sp; i++) {
+		if (nls_eval_stack[i].nee_func) {
+			nls_grab(nls_eval_stack[i].nee_func);
+		}
+	}
+	nls_closure_safepoint();
+	nls_memo_safepoint();
+	nls_mem_safepoint();
+	for (i = 0; i < nls_eval_sp; i++) {
+		if (nls_eval_stack[i].nee_func) {
+			nls_release(nls_eval_stack[i].nee_func);
+		}
+	}
+}
+
+/*
+ * Drop the entries above base after an error.
+ */
+static void
+nls_eval_unwind(int base)
+{
+	while (base < nls_eval_sp) {
+		free(nls_eval_stack[--nls_eval_sp].nee_memo);
+	}
+}
+
+/*
+ * Whether func is a global whose definition is memoized, and applied
+ * to all its arguments.
+ */
+static int
+nls_eval_memoized(nls_node *func, nls_node *args)
+{
+	int slot;
+	nls_node *def;
+
+	if (!NLS_ISVAR(func) || 0 > (slot = nls_symbol_resolve(func)) ||
+		!nls_sym_info_of[slot].nsi_memo) {
+		return 0;
+	}
+	def = nls_sym_slots[slot];
+	return NLS_TYPE_ABSTRACTION == NLS_NODE_TYPE(def) &&
+		def->nn_abst.nab_num_args == nls_list_count(args);
+}
+
+/*
+ * Push the arguments in reverse, so that the first is reduced first.
+ */
+static int
+nls_eval_push_args(nls_node *args)
+{
+	int ret;
+
+	if (!args) {
+		return 0;
+	}
+	if ((ret = nls_eval_push_args(args->nn_list.nl_rest))) {
+		return ret;
+	}
+	return nls_eval_push(&(args->nn_list.nl_head), args, NLS_EVAL_START);
+}
+
+static int
+nls_eval_max_depth(void)
+{
+	return nls_sys_config.nc_max_depth ?
+		nls_sys_config.nc_max_depth : NLS_EVAL_MAX_DEPTH;
+}
+
+/**
+ * Enter a reduction nested on the C stack, as the environment, VM and
+ * closure evaluators (and hot globals) recurse, to fail instead of
+ * overflowing the C stack: at nc_max_depth, which may only lower the
+ * stack-safe NLS_EVAL_MAX_NESTED.
+ * @retval 0         Entered: nls_eval_leave() once it returns.
+ * @retval EOVERFLOW Too deep.
+ */
+int
+nls_eval_enter(void)
+{
+	int max = NLS_EVAL_MAX_NESTED;
+
+	if (nls_sys_config.nc_max_depth && nls_sys_config.nc_max_depth < max) {
+		max = nls_sys_config.nc_max_depth;
+	}
+
+	if (nls_eval_nested >= max) {
+		NLS_ERROR(NLS_MSG_TOO_DEEP ": max=%d", max);
+		return EOVERFLOW;
+	}
+	nls_eval_nested++;
+	return 0;
+}
+
+/**
+ * Leave a reduction entered by nls_eval_enter().
+ */
+void
+nls_eval_leave(void)
+{
+	nls_eval_nested--;
+}
+
+/*
+ * Evaluate a top-level expression with the compiler selected, if any.
+ */
+static int
+nls_eval_top(nls_node **tree)
+{
+	switch (nls_sys_config.nc_eval) {
+	case NLS_EVAL_VM:
+		return nls_vm_eval(tree);
+	case NLS_EVAL_CLOSURE:
+		return nls_closure_eval(tree);
+	default:
+		return nls_eval(tree);
+	}
+}
+
+/**
+ * Bind the free variables of a tree to global slots.
+ */
+static void
+nls_resolve(nls_node *tree)
+{
+	nls_node **item, *tmp;
+
+	switch (NLS_NODE_TYPE(tree)) {
+	case NLS_TYPE_VAR:
+		if (tree->nn_var.nv_index < 0) {
+			nls_symbol_resolve(tree);
+		}
+		break;
+	case NLS_TYPE_ABSTRACTION:
+		nls_resolve(tree->nn_abst.nab_def);
+		break;
+	case NLS_TYPE_APPLICATION:
+		nls_resolve(tree->nn_app.nap_func);
+		nls_resolve(tree->nn_app.nap_args);
+		break;
+	case NLS_TYPE_LIST:
+		nls_list_foreach(tree, &item, &tmp) {
+			nls_resolve(*item);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * Get the global slot of a variable, resolving it on first use.
+ * @return Slot number, or -1 when out of memory.
+ */
+int
+nls_symbol_resolve(nls_node *var)
+{
+	if (var->nn_var.nv_slot < 0) {
+		var->nn_var.nv_slot = nls_symbol_slot(var->nn_var.nv_name);
+	}
+	return var->nn_var.nv_slot;
 }
 
 nls_node*
-nls_symbol_get(nls_string *name)
+nls_symbol_get(nls_node *var)
 {
-	nls_hash_entry *ent, *prev;
+	int slot = nls_symbol_resolve(var);
 
-	ent = nls_hash_search(&nls_sym_table, name, &prev);
-	if (!ent) {
+	if (slot < 0) {
 		return NULL;
 	}
-	return ent->nhe_node;
+	return nls_sym_slots[slot];
+}
+
+void
+nls_symbol_set(nls_node *var, nls_node *node)
+{
+	int slot = nls_symbol_resolve(var);
+
+	if (slot < 0) {
+		return;
+	}
+	if (!nls_arena_active()) {
+		nls_slot_store(slot, node);
+		return;
+	}
+	/* The symbol table outlives the arena: promote a copy to the heap. */
+	nls_arena_suspend();
+	node = nls_node_clone(node); /* The name is interned already. */
+	if (!node) {
+		NLS_ERROR(NLS_MSG_ENOMEM);
+		nls_arena_resume();
+		return;
+	}
+	nls_slot_store(slot, node);
+	nls_arena_resume();
+}
+
+/**
+ * Count a call of the abstraction a global holds.
+ * @return Nonzero once the definition is hot, and should run compiled.
+ */
+int
+nls_symbol_hot(nls_node *var)
+{
+	nls_sym_info *info;
+	int slot = nls_symbol_resolve(var);
+
+	if (slot < 0) {
+		return 0;
+	}
+	info = &nls_sym_info_of[slot];
+	info->nsi_total++;
+	if (!nls_sys_config.nc_tier_threshold ||
+		++info->nsi_calls < nls_sys_config.nc_tier_threshold) {
+		return 0;
+	}
+	if (info->nsi_calls == nls_sys_config.nc_tier_threshold) {
+		info->nsi_promoted++;
+	}
+	return 1;
+}
+
+/**
+ * Memoize the results of the current definition of a global.
+ */
+void
+nls_symbol_memoize(nls_node *var)
+{
+	int slot = nls_symbol_resolve(var);
+
+	if (slot < 0) {
+		return;
+	}
+	nls_sym_info_of[slot].nsi_memo = 1;
 }
 
+/**
+ * Note that a call of a global has been inlined, so setting it must
+ * start a new epoch of folding.
+ */
 void
-nls_symbol_set(nls_string *name, nls_node *node)
+nls_symbol_inlined(nls_node *var)
+{
+	int slot = nls_symbol_resolve(var);
+
+	if (slot < 0) {
+		return;
+	}
+	nls_sym_info_of[slot].nsi_inlined = 1;
+}
+
+/**
+ * The abstraction a global holds, folded as of the current epoch (see
+ * nls_fold_epoch()). Folded lazily, and again in each new epoch.
+ * @return The folded abstraction, or the definition itself.
+ */
+nls_node*
+nls_symbol_folded(nls_node *var)
 {
-	nls_hash_add(&nls_sym_table, name, node);
+	nls_sym_info *info;
+	nls_node *folded;
+	int slot = nls_symbol_resolve(var);
+
+	if (slot < 0) {
+		return nls_symbol_get(var);
+	}
+	info = &nls_sym_info_of[slot];
+	if (info->nsi_folded && info->nsi_fold_epoch == nls_fold_epoch()) {
+		return info->nsi_folded;
+	}
+	if (info->nsi_folded) {
+		nls_release(info->nsi_folded);
+		info->nsi_folded = NULL;
+	}
+	/* Kept across expressions: not from an arena. */
+	nls_arena_suspend();
+	folded = nls_fold_abstraction(nls_sym_slots[slot]);
+	nls_arena_resume();
+	if (!folded) {
+		return nls_sym_slots[slot];
+	}
+	info->nsi_folded = folded;
+	info->nsi_fold_epoch = nls_fold_epoch();
+	return folded;
+}
+
+/*
+ * Slot number of a global name. A new name gets an empty slot.
+ */
+static int
+nls_symbol_slot(nls_string *name)
+{
+	nls_node *num;
+	nls_hash_entry *ent = nls_hash_search(&nls_sym_table, name);
+
+	if (ent) {
+		return NLS_INT_VAL(ent->nhe_node);
+	}
+	if (nls_sym_num == nls_sym_size) {
+		int size = nls_sym_size ? 2 * nls_sym_size : NLS_SYM_SLOTS_INIT_SIZE;
+		nls_node **slots = realloc(nls_sym_slots, size * sizeof(nls_node*));
+		nls_sym_info *info;
+
+		if (!slots) {
+			NLS_ERROR(NLS_MSG_ENOMEM);
+			return -1;
+		}
+		nls_sym_slots = slots;
+		info = realloc(nls_sym_info_of, size * sizeof(nls_sym_info));
+		if (!info) {
+			NLS_ERROR(NLS_MSG_ENOMEM);
+			return -1;
+		}
+		nls_sym_info_of = info;
+		nls_sym_size = size;
+	}
+	nls_arena_suspend();
+	num = nls_int_new(nls_sym_num);
+	if (!num || nls_hash_add(&nls_sym_table, name, num)) {
+		NLS_ERROR(NLS_MSG_ENOMEM);
+		if (num) {
+			nls_node_free(num);
+		}
+		nls_arena_resume();
+		return -1;
+	}
+	nls_arena_resume();
+	nls_sym_slots[nls_sym_num] = NULL;
+	memset(&nls_sym_info_of[nls_sym_num], 0, sizeof(nls_sym_info));
+	return nls_sym_num++;
+}
+
+static void
+nls_slot_store(int slot, nls_node *node)
+{
+	nls_node *old = nls_sym_slots[slot];
+
+	nls_sym_slots[slot] = nls_grab(node); /* A root: no write barrier */
+	/* A new definition starts cold, and unmemoized. */
+	nls_sym_info_of[slot].nsi_calls = 0;
+	nls_sym_info_of[slot].nsi_memo = 0;
+	if (nls_sym_info_of[slot].nsi_folded) {
+		nls_release(nls_sym_info_of[slot].nsi_folded);
+		nls_sym_info_of[slot].nsi_folded = NULL;
+	}
+	nls_memo_invalidate();
+	if (nls_sym_info_of[slot].nsi_inlined) {
+		/* Whatever inlined the old definition is stale. */
+		nls_sym_info_of[slot].nsi_inlined = 0;
+		nls_fold_invalidate();
+	}
+	if (old) {
+		if (NLS_TYPE_FUNCTION == NLS_NODE_TYPE(old)) {
+			/* Whatever folded calls of the builtin is stale. */
+			nls_fold_invalidate();
+		}
+		nls_release(old);
+	}
 }
 
 static void
 nls_sym_table_init(void)
 {
 	nls_hash_init(&nls_sym_table);
-#define NLS_SYM_TABLE_ADD_FUNC(fp, n, name) \
+	nls_sym_slots = NULL;
+	nls_sym_num  = 0;
+	nls_sym_size = 0;
+#ifdef NLS_GC
+	nls_gc_root_add(nls_sym_table_trace);
+#endif /* NLS_GC */
+#define NLS_SYM_TABLE_ADD_FUNC(fp, n, strict, name) \
 	do { \
-		nls_node *func = nls_function_new((fp), (n), (name)); \
+		int slot; \
+		nls_node *func = nls_function_new((fp), (n), (strict), (name)); \
 		if (!func) { \
 			NLS_ERROR(NLS_MSG_ENOMEM); \
 			return; \
 		} \
-		nls_symbol_set(func->nn_func.nf_name, func); \
+		if ((slot = nls_symbol_slot(func->nn_func.nf_name)) < 0) { \
+			nls_node_free(func); \
+			return; \
+		} \
+		nls_slot_store(slot, func); \
 	} while(0)
-	NLS_SYM_TABLE_ADD_FUNC(nls_func_add,  2, "add");
-	NLS_SYM_TABLE_ADD_FUNC(nls_func_sub,  2, "sub");
-	NLS_SYM_TABLE_ADD_FUNC(nls_func_mul,  2, "mul");
-	NLS_SYM_TABLE_ADD_FUNC(nls_func_div,  2, "div");
-	NLS_SYM_TABLE_ADD_FUNC(nls_func_mod,  2, "mod");
-	NLS_SYM_TABLE_ADD_FUNC(nls_func_abst, 2, "abst");
-	NLS_SYM_TABLE_ADD_FUNC(nls_func_set,  2, "set");
+	NLS_SYM_TABLE_ADD_FUNC(nls_func_add,  2, 1, "add");
+	NLS_SYM_TABLE_ADD_FUNC(nls_func_sub,  2, 1, "sub");
+	NLS_SYM_TABLE_ADD_FUNC(nls_func_mul,  2, 1, "mul");
+	NLS_SYM_TABLE_ADD_FUNC(nls_func_div,  2, 1, "div");
+	NLS_SYM_TABLE_ADD_FUNC(nls_func_mod,  2, 1, "mod");
+	NLS_SYM_TABLE_ADD_FUNC(nls_func_abst, 2, 0, "abst");
+	NLS_SYM_TABLE_ADD_FUNC(nls_func_set,  2, 0, "set");
+	NLS_SYM_TABLE_ADD_FUNC(nls_func_memo, 1, 0, "memo");
 #undef  NLS_SYM_TABLE_ADD_FUNC
 }
 
 static void
 nls_sym_table_term(void)
 {
+	int i;
+
+	for (i = 0; i < nls_sym_num; i++) {
+		if (nls_sym_slots[i]) {
+			nls_release(nls_sym_slots[i]);
+		}
+		if (nls_sym_info_of[i].nsi_folded) {
+			nls_release(nls_sym_info_of[i].nsi_folded);
+		}
+	}
+	free(nls_sym_slots);
+	free(nls_sym_info_of);
+	nls_sym_slots = NULL;
+	nls_sym_info_of = NULL;
+	nls_sym_num  = 0;
+	nls_sym_size = 0;
 	nls_hash_term(&nls_sym_table);
 }
 
+/*
+ * Calls of each global called, and how many of its definitions were
+ * promoted to compiled code.
+ */
+static void
+nls_sym_calls_print(FILE *out)
+{
+	size_t i;
+	nls_sym_info *info;
+	nls_hash_entry *ent;
+
+	for (i = 0; i < nls_sym_table.nh_size; i++) {
+		if (!(ent = nls_sym_table.nh_table[i])) {
+			continue;
+		}
+		info = &nls_sym_info_of[NLS_INT_VAL(ent->nhe_node)];
+		if (!info->nsi_total) {
+			continue;
+		}
+		fprintf(out, "calls: %s: %lu, promoted: %d\n",
+			ent->nhe_key->ns_buf, info->nsi_total, info->nsi_promoted);
+	}
+}
+
+#ifdef NLS_GC
+/*
+ * Visit the trees on the stack, moving each slot along with the object
+ * holding it.
+ */
+static void
+nls_eval_stack_trace(void)
+{
+	int i;
+	size_t offset;
+	nls_eval_entry *ent;
+
+	for (i = 0; i < nls_eval_sp; i++) {
+		ent = &nls_eval_stack[i];
+		if (ent->nee_owner) {
+			offset = (char*)ent->nee_tree - (char*)ent->nee_owner;
+			nls_gc_visit(&ent->nee_owner);
+			ent->nee_tree = (nls_node**)((char*)ent->nee_owner + offset);
+		}
+		nls_gc_visit(ent->nee_tree);
+		nls_gc_visit(&ent->nee_func);
+	}
+}
+
+static void
+nls_sym_table_trace(void)
+{
+	int i;
+
+	for (i = 0; i < nls_sym_num; i++) {
+		nls_gc_visit(&nls_sym_slots[i]);
+		nls_gc_visit(&nls_sym_info_of[i].nsi_folded);
+	}
+	nls_hash_trace(&nls_sym_table);
+}
+#endif /* NLS_GC */
+
 static int
 nls_apply(nls_node **tree)
 {
 	nls_application *app = &((*tree)->nn_app);
 	nls_node *func = app->nap_func;
 
+	if (NLS_ISIMM(func)) {
+		return 0; /* An int applies to nothing. */
+	}
 	return ((func)->nn_op->nop_apply)(tree);
 }
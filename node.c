@@ -15,6 +15,8 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <stdint.h>
+#include <stdlib.h>
 #include <errno.h>
 #include <string.h>
 #include <stdio.h>
@@ -26,7 +28,8 @@
 #define NLS_ANON_VAR_PREFIX 'x'
 
 #define NLS_MSG_BROKEN_LIST "Broken list"
-#define NLS_MSG_NO_SUCH_SYMBOL "No such symbol"
+
+#define NLS_NODE_TABLE_INIT_SIZE 256
 
 #define NLS_TYPE_int		NLS_TYPE_INT
 #define NLS_TYPE_var		NLS_TYPE_VAR
@@ -45,12 +48,33 @@
 		.nop_print   = nls_##type##_print, \
 		.nop_apply   = nls_##type##_apply, \
 		.nop_bound_vars = nls_##type##_bound_vars, \
+		.nop_subst   = nls_##type##_subst, \
 	}
 
+/*
+ * Interned nodes, by open addressing with linear probing. The table
+ * holds one reference to each, so an interned node is never unique to
+ * its users and never recycled in place.
+ */
+static nls_node **nls_node_table;
+static size_t nls_node_table_num;
+static size_t nls_node_table_size;
+static size_t nls_node_table_swept; /* nls_node_table_num after a sweep */
+
 static nls_node* _nls_node_new(nls_node_type_t type, nls_node_operations *op);
+static uint32_t nls_node_hash(nls_node *node);
+static int nls_node_same(nls_node *node1, nls_node *node2);
+static nls_node** nls_node_table_find(nls_node *node, uint32_t hash);
+static int nls_node_table_rehash(size_t size);
+#ifdef NLS_GC
+static void nls_node_table_trace(void);
+#endif /* NLS_GC */
 static void nls_list_item_free(nls_node *node);
 static nls_node* nls_list_tail_entry(nls_node *node);
-static void nls_bound_vars(nls_node **tree, nls_node *var);
+static void nls_bound_vars(nls_node *tree, nls_node *vars, int depth);
+static void nls_subst(nls_node **tree, nls_node *args, int n, int depth);
+static nls_node* nls_list_nth(nls_node *list, int n);
+static nls_node* nls_list_inst(nls_node *list, void *frame, int depth, nls_node_lookup lookup);
 
 static void nls_int_release(nls_node *tree);
 static void nls_var_release(nls_node *tree);
@@ -80,15 +104,21 @@ static int nls_abstraction_apply(nls_node **tree);
 static int nls_application_apply(nls_node **tree);
 static int nls_list_apply(nls_node **tree);
 
-static void nls_int_bound_vars(nls_node **tree, nls_node *var);
-static void nls_var_bound_vars(nls_node **tree, nls_node *var);
-static void nls_function_bound_vars(nls_node **tree, nls_node *var);
-static void nls_abstraction_bound_vars(nls_node **tree, nls_node *var);
-static void nls_application_bound_vars(nls_node **tree, nls_node *var);
-static void nls_list_bound_vars(nls_node **tree, nls_node *var);
+static void nls_int_bound_vars(nls_node *tree, nls_node *vars, int depth);
+static void nls_var_bound_vars(nls_node *tree, nls_node *vars, int depth);
+static void nls_function_bound_vars(nls_node *tree, nls_node *vars, int depth);
+static void nls_abstraction_bound_vars(nls_node *tree, nls_node *vars, int depth);
+static void nls_application_bound_vars(nls_node *tree, nls_node *vars, int depth);
+static void nls_list_bound_vars(nls_node *tree, nls_node *vars, int depth);
+
+static void nls_int_subst(nls_node **tree, nls_node *args, int n, int depth);
+static void nls_var_subst(nls_node **tree, nls_node *args, int n, int depth);
+static void nls_function_subst(nls_node **tree, nls_node *args, int n, int depth);
+static void nls_abstraction_subst(nls_node **tree, nls_node *args, int n, int depth);
+static void nls_application_subst(nls_node **tree, nls_node *args, int n, int depth);
+static void nls_list_subst(nls_node **tree, nls_node *args, int n, int depth);
 
 static int nls_function_part_apply(nls_node *func, nls_node *args, nls_node **out);
-static void nls_replace_vars(nls_node *vars, nls_node *args);
 static void nls_remove_head_vars(nls_node *func, int n);
 static nls_node* nls_vars_new(int n);
 
@@ -99,17 +129,89 @@ NLS_DEF_NODE_OPERATIONS(abstraction);
 NLS_DEF_NODE_OPERATIONS(application);
 NLS_DEF_NODE_OPERATIONS(list);
 
+#define NLS_NODE_OP(node) \
+	(NLS_ISIMM(node) ? &nls_int_operations : (node)->nn_op)
+
 void
 nls_node_free(void *ptr)
 {
 	nls_node *node = (nls_node*)ptr;
 
+	if (NLS_ISIMM(node)) {
+		return;
+	}
 	node->nn_op->nop_release(node);
 	nls_free(node);
 }
 
+#ifdef NLS_GC
+void
+nls_node_trace(void *ptr)
+{
+	nls_node *node = (nls_node*)ptr;
+
+	switch (node->nn_type) {
+	case NLS_TYPE_INT:
+		break;
+	case NLS_TYPE_VAR:
+		nls_gc_visit(&node->nn_var.nv_name);
+		break;
+	case NLS_TYPE_FUNCTION:
+		nls_gc_visit(&node->nn_func.nf_name);
+		break;
+	case NLS_TYPE_ABSTRACTION:
+		nls_gc_visit(&node->nn_abst.nab_vars);
+		nls_gc_visit(&node->nn_abst.nab_def);
+		break;
+	case NLS_TYPE_APPLICATION:
+		nls_gc_visit(&node->nn_app.nap_func);
+		nls_gc_visit(&node->nn_app.nap_args);
+		break;
+	case NLS_TYPE_LIST:
+		nls_gc_visit(&node->nn_list.nl_head);
+		nls_gc_visit(&node->nn_list.nl_rest);
+		break;
+	default:
+		NLS_BUG(NLS_MSG_INVALID_NODE_TYPE ": type=%d", node->nn_type);
+	}
+}
+#endif /* NLS_GC */
+
+/**
+ * Int node, an immediate unless val is too wide for one.
+ */
 nls_node*
 nls_int_new(int val)
+{
+	if (NLS_IMM_INT_FITS(val)) {
+		return NLS_IMM_INT(val);
+	}
+	return nls_int_box(val);
+}
+
+#ifdef NLS_UNIT_TEST
+static void
+test_nls_int_new(void)
+{
+	nls_node *zero = nls_int_new(0);
+	nls_node *neg = nls_int_new(-7);
+
+	NLS_ASSERT(zero);
+	NLS_ASSERT(NLS_ISINT(zero));
+	NLS_ASSERT_EQUALS(0, NLS_INT_VAL(zero));
+	NLS_ASSERT(NLS_ISINT(neg));
+	NLS_ASSERT_EQUALS(-7, NLS_INT_VAL(neg));
+	NLS_ASSERT_EQUALS(neg, nls_int_new(-7));
+	NLS_ASSERT_EQUALS(neg, nls_grab(neg)); /* Not counted */
+	nls_release(neg);
+}
+#endif /* NLS_UNIT_TEST */
+
+/**
+ * Int node on the heap.
+ */
+nls_node*
+nls_int_box(int val)
 {
 	nls_node *node = NLS_NODE_NEW(int);
 
@@ -120,6 +222,20 @@ nls_int_new(int val)
 	return node;
 }
 
+#ifdef NLS_UNIT_TEST
+static void
+test_nls_int_box(void)
+{
+	nls_node *node = nls_grab(nls_int_box(-7));
+
+	NLS_ASSERT_NOT(NLS_ISIMM(node));
+	NLS_ASSERT(NLS_ISINT(node));
+	NLS_ASSERT_EQUALS(-7, NLS_INT_VAL(node));
+	NLS_ASSERT(nls_node_equal(node, nls_int_new(-7)));
+	nls_release(node);
+}
+#endif /* NLS_UNIT_TEST */
+
 nls_node*
 nls_var_new(nls_string *name)
 {
@@ -128,48 +244,70 @@ nls_var_new(nls_string *name)
 	if (!node) {
 		return NULL;
 	}
-	node->nn_var.nv_next_ref = NULL;
 	node->nn_var.nv_name = nls_grab(name);
+	node->nn_var.nv_slot = -1;
+	node->nn_var.nv_index = -1;
 	return node;
 }
 
 nls_node*
-nls_function_new(nls_fp fp, int num_args, char *name)
+nls_function_new(nls_fp fp, int num_args, int strict, char *name)
 {
 	nls_node *node;
-	nls_string *str = nls_string_new(name);
+	nls_string *str = nls_string_intern(name);
 
-	if (!name) {
+	if (!str) {
 		return NULL;
 	}
 	node = NLS_NODE_NEW(function);
 	if (!node) {
-		nls_string_free(str);
 		return NULL;
 	}
 	node->nn_func.nf_num_args = num_args;
+	node->nn_func.nf_strict = strict;
 	node->nn_func.nf_name = nls_grab(str);
 	node->nn_func.nf_fp = fp;
 	return node;
 }
 
+/**
+ * Make an abstraction, turning the variables of def named after one of
+ * vars into indices.
+ */
 nls_node*
 nls_abstraction_new(nls_node *vars, nls_node *def)
 {
 	int n = nls_list_count(vars);
 	nls_abstraction *abst;
 	nls_node *node;
-	nls_node **var, *tmp;
 
 	if (!(node = NLS_NODE_NEW(abstraction))) {
 		return NULL;
 	}
+	nls_bound_vars(def, vars, 0);
+	abst = &(node->nn_abst);
+	abst->nab_num_args = n;
+	abst->nab_code = 0;
+	abst->nab_vars = nls_grab(vars);
+	abst->nab_def  = nls_grab(def);
+	return node;
+}
 
-	nls_list_foreach(vars, &var, &tmp) {
-		nls_bound_vars(&def, *var);
+/**
+ * Make an abstraction whose body refers to vars by index already.
+ */
+nls_node*
+nls_abstraction_new_bound(nls_node *vars, nls_node *def)
+{
+	nls_abstraction *abst;
+	nls_node *node = NLS_NODE_NEW(abstraction);
+
+	if (!node) {
+		return NULL;
 	}
 	abst = &(node->nn_abst);
-	abst->nab_num_args = n;
+	abst->nab_num_args = nls_list_count(vars);
+	abst->nab_code = 0;
 	abst->nab_vars = nls_grab(vars);
 	abst->nab_def  = nls_grab(def);
 	return node;
@@ -205,12 +343,371 @@ nls_list_new(nls_node *item)
 	return node;
 }
 
+/**
+ * Make cell, not allocated by nls_new(), a list of item alone.
+ * Such a list must never be grabbed: release its items by hand.
+ */
+void
+nls_list_init(nls_node *cell, nls_node *item)
+{
+	cell->nn_type = NLS_TYPE_LIST;
+	cell->nn_hash = 0;
+	cell->nn_op = &nls_list_operations;
+	cell->nn_list.nl_head = nls_grab(item);
+	cell->nn_list.nl_rest = NULL;
+}
+
 nls_node*
 nls_node_clone(nls_node *tree)
 {
-	return tree->nn_op->nop_clone(tree);
+	return NLS_NODE_OP(tree)->nop_clone(tree);
 }
 
+/**
+ * Replace the indices of term bound in frame, depth parameters further
+ * out, with the arguments lookup finds for them: the frames of the
+ * compiling evaluators (vm.c, closure.c, aot.c) hold the argument terms
+ * of their thunks. Unchanged subtrees are shared.
+ * @return Reference to the instance, NULL if out of memory or unbound.
+ */
+nls_node*
+nls_node_inst(nls_node *term, void *frame, int depth, nls_node_lookup lookup)
+{
+	nls_node *node, *part;
+	void *arg_frame;
+
+	if (!frame) {
+		return nls_grab(term);
+	}
+	switch (NLS_NODE_TYPE(term)) {
+	case NLS_TYPE_VAR:
+		if (term->nn_var.nv_index < depth) {
+			return nls_grab(term);
+		}
+		if (!(node = (lookup)(term, frame, depth, &arg_frame))) {
+			return NULL;
+		}
+		return nls_node_inst(node, arg_frame, 0, lookup);
+	case NLS_TYPE_ABSTRACTION:
+		part = nls_node_inst(term->nn_abst.nab_def, frame,
+			depth + term->nn_abst.nab_num_args, lookup);
+		if (!part || part == term->nn_abst.nab_def) {
+			break;
+		}
+		node = nls_abstraction_new_bound(term->nn_abst.nab_vars, part);
+		nls_release(part);
+		return node ? nls_grab(node) : NULL;
+	case NLS_TYPE_APPLICATION:
+		/* Only arguments are bound. */
+		part = nls_list_inst(term->nn_app.nap_args, frame, depth, lookup);
+		if (!part || part == term->nn_app.nap_args) {
+			break;
+		}
+		node = nls_application_new(term->nn_app.nap_func, part);
+		nls_release(part);
+		return node ? nls_grab(node) : NULL;
+	case NLS_TYPE_LIST:
+		return nls_list_inst(term, frame, depth, lookup);
+	default:
+		return nls_grab(term);
+	}
+	if (!part) {
+		return NULL;
+	}
+	nls_release(part);
+	return nls_grab(term);
+}
+
+/**
+ * Whether term has no variable bound outside of it, depth parameters in.
+ */
+int
+nls_node_closed(nls_node *term, int depth)
+{
+	nls_node **item, *tmp;
+
+	switch (NLS_NODE_TYPE(term)) {
+	case NLS_TYPE_VAR:
+		return term->nn_var.nv_index < depth;
+	case NLS_TYPE_ABSTRACTION:
+		return nls_node_closed(term->nn_abst.nab_def,
+			depth + term->nn_abst.nab_num_args);
+	case NLS_TYPE_APPLICATION:
+		return nls_node_closed(term->nn_app.nap_args, depth);
+	case NLS_TYPE_LIST:
+		nls_list_foreach(term, &item, &tmp) {
+			if (!nls_node_closed(*item, depth)) {
+				return 0;
+			}
+		}
+		return 1;
+	default:
+		return 1;
+	}
+}
+
+/**
+ * Replace *tree by the interned node structurally equal to it, interning
+ * *tree itself if there is none yet (hash-consing). Ints, variables,
+ * functions and lists of them are interned; within other nodes, the
+ * parts that are get shared in place. Nothing is interned while an arena
+ * is active.
+ * @param  tree Slot holding a reference.
+ * @return Nonzero if *tree is interned.
+ */
+int
+nls_node_intern(nls_node **tree)
+{
+	uint32_t hash;
+	nls_node **ent, *node = *tree;
+	nls_list *list;
+
+	if (NLS_ISIMM(node) || node->nn_hash) {
+		return 1; /* Equal immediates are the same pointer. */
+	}
+	if (nls_arena_active()) {
+		return 0;
+	}
+	switch (node->nn_type) {
+	case NLS_TYPE_INT:
+	case NLS_TYPE_VAR:
+	case NLS_TYPE_FUNCTION:
+		break;
+	case NLS_TYPE_ABSTRACTION:
+		nls_node_intern(&node->nn_abst.nab_vars);
+		nls_node_intern(&node->nn_abst.nab_def);
+		return 0;
+	case NLS_TYPE_APPLICATION:
+		nls_node_intern(&node->nn_app.nap_func);
+		nls_node_intern(&node->nn_app.nap_args);
+		return 0;
+	case NLS_TYPE_LIST:
+		list = &(node->nn_list);
+		if (!nls_node_intern(&list->nl_head)) {
+			if (list->nl_rest) {
+				nls_node_intern(&list->nl_rest);
+			}
+			return 0;
+		}
+		if (list->nl_rest && !nls_node_intern(&list->nl_rest)) {
+			return 0;
+		}
+		break;
+	default:
+		NLS_BUG(NLS_MSG_INVALID_NODE_TYPE ": type=%d", node->nn_type);
+		return 0;
+	}
+	hash = nls_node_hash(node);
+	if (nls_node_table_size && *(ent = nls_node_table_find(node, hash))) {
+		*tree = nls_grab(*ent);
+		nls_release(node);
+		return 1;
+	}
+	if (4 * (nls_node_table_num + 1) > 3 * nls_node_table_size
+		&& nls_node_table_rehash(nls_node_table_size ?
+			2 * nls_node_table_size : NLS_NODE_TABLE_INIT_SIZE)) {
+		return 0;
+	}
+	node->nn_hash = hash;
+	*nls_node_table_find(node, hash) = nls_grab(node);
+	nls_node_table_num++;
+	return 1;
+}
+
+#ifdef NLS_UNIT_TEST
+static void
+test_nls_node_intern(void)
+{
+	nls_string *name = nls_string_intern("x");
+	nls_node *var1 = nls_grab(nls_var_new(name));
+	nls_node *var2 = nls_grab(nls_var_new(name));
+	nls_node *list1 = nls_grab(nls_list_new(nls_var_new(name)));
+	nls_node *list2 = nls_grab(nls_list_new(nls_var_new(name)));
+	nls_node *list3 = nls_grab(nls_list_new(nls_int_new(2)));
+
+	nls_list_add(list1, nls_int_new(2));
+	nls_list_add(list2, nls_int_new(2));
+	nls_list_add(list3, nls_var_new(name));
+
+	NLS_ASSERT(nls_node_intern(&var1));
+	NLS_ASSERT(nls_node_intern(&var2));
+	NLS_ASSERT_EQUALS(var1, var2);
+	NLS_ASSERT_NOT(nls_is_unique(var1)); /* Also held by the table */
+
+	NLS_ASSERT(nls_node_intern(&list1));
+	NLS_ASSERT(nls_node_intern(&list2));
+	NLS_ASSERT(nls_node_intern(&list3));
+	NLS_ASSERT_EQUALS(list1, list2);
+	NLS_ASSERT_NOT_EQUALS(list1, list3);
+	NLS_ASSERT_EQUALS(var1, list1->nn_list.nl_head);
+	NLS_ASSERT_EQUALS(var1, list3->nn_list.nl_rest->nn_list.nl_head);
+
+	nls_release(var1);
+	nls_release(var2);
+	nls_release(list1);
+	nls_release(list2);
+	nls_release(list3);
+}
+#endif /* NLS_UNIT_TEST */
+
+/**
+ * Tell if two trees are structurally equal. Distinct interned nodes
+ * never are, so comparing two interned nodes takes O(1).
+ */
+int
+nls_node_equal(nls_node *node1, nls_node *node2)
+{
+	nls_node *rest1, *rest2;
+
+	if (node1 == node2) {
+		return 1;
+	}
+	if (NLS_NODE_TYPE(node1) != NLS_NODE_TYPE(node2)) {
+		return 0;
+	}
+	if (NLS_ISINT(node1)) {
+		return NLS_INT_VAL(node1) == NLS_INT_VAL(node2);
+	}
+	if (node1->nn_hash && node2->nn_hash) {
+		return 0;
+	}
+	switch (node1->nn_type) {
+	case NLS_TYPE_ABSTRACTION:
+		return nls_node_equal(node1->nn_abst.nab_vars,
+				node2->nn_abst.nab_vars)
+			&& nls_node_equal(node1->nn_abst.nab_def,
+				node2->nn_abst.nab_def);
+	case NLS_TYPE_APPLICATION:
+		return nls_node_equal(node1->nn_app.nap_func,
+				node2->nn_app.nap_func)
+			&& nls_node_equal(node1->nn_app.nap_args,
+				node2->nn_app.nap_args);
+	case NLS_TYPE_LIST:
+		if (!nls_node_equal(node1->nn_list.nl_head,
+				node2->nn_list.nl_head)) {
+			return 0;
+		}
+		rest1 = node1->nn_list.nl_rest;
+		rest2 = node2->nn_list.nl_rest;
+		if (!rest1 || !rest2) {
+			return rest1 == rest2;
+		}
+		return nls_node_equal(rest1, rest2);
+	default:
+		return nls_node_same(node1, node2);
+	}
+}
+
+#ifdef NLS_UNIT_TEST
+static void
+test_nls_node_equal(void)
+{
+	nls_node *list1 = nls_grab(nls_list_new(nls_int_new(1)));
+	nls_node *list2 = nls_grab(nls_list_new(nls_int_new(1)));
+
+	NLS_ASSERT(nls_node_equal(list1, list2));
+	nls_list_add(list2, nls_int_new(2));
+	NLS_ASSERT_NOT(nls_node_equal(list1, list2));
+	NLS_ASSERT_NOT(nls_node_equal(list2, list1));
+
+	nls_release(list1);
+	nls_release(list2);
+}
+#endif /* NLS_UNIT_TEST */
+
+void
+nls_node_table_init(void)
+{
+	nls_node_table = NULL; /* Allocated by the first nls_node_intern(). */
+	nls_node_table_num  = 0;
+	nls_node_table_size = 0;
+	nls_node_table_swept = 0;
+#ifdef NLS_GC
+	nls_gc_root_add(nls_node_table_trace);
+#endif /* NLS_GC */
+}
+
+void
+nls_node_table_term(void)
+{
+	size_t i;
+
+	for (i = 0; i < nls_node_table_size; i++) {
+		if (nls_node_table[i]) {
+			nls_release(nls_node_table[i]);
+		}
+	}
+	free(nls_node_table);
+	nls_node_table = NULL;
+	nls_node_table_num  = 0;
+	nls_node_table_size = 0;
+	nls_node_table_swept = 0;
+}
+
+/**
+ * Drop the interned nodes that only the table refers to. Call it where
+ * no node is held without a reference, e.g. between top-level
+ * expressions. The table is only scanned once it has doubled since the
+ * last sweep. GC builds cannot tell, and keep every interned node.
+ */
+void
+nls_node_table_sweep(void)
+{
+	size_t i, size = nls_node_table_size;
+	nls_node **table = nls_node_table;
+
+	if (nls_node_table_num < 2 * nls_node_table_swept
+		|| nls_node_table_num < NLS_NODE_TABLE_INIT_SIZE / 2) {
+		return;
+	}
+	if (!(nls_node_table = calloc(size, sizeof(nls_node*)))) {
+		nls_node_table = table;
+		return;
+	}
+	for (i = 0; i < size; i++) {
+		nls_node *node = table[i];
+
+		if (!node) {
+			continue;
+		}
+		if (nls_is_unique(node)) {
+			/* Interned parts it frees go on the next sweep. */
+			nls_node_table_num--;
+			nls_release(node);
+			continue;
+		}
+		*nls_node_table_find(node, node->nn_hash) = node;
+	}
+	free(table);
+	nls_node_table_swept = nls_node_table_num;
+}
+
+#ifdef NLS_UNIT_TEST
+static void
+test_nls_node_table_sweep(void)
+{
+	int i;
+	nls_node *kept = nls_grab(nls_int_box(-1));
+	nls_node *same = nls_grab(nls_int_box(-1));
+
+	nls_node_intern(&kept);
+	for (i = 0; i < NLS_NODE_TABLE_INIT_SIZE; i++) {
+		nls_node *node = nls_grab(nls_int_box(i + 1000));
+
+		nls_node_intern(&node);
+		nls_release(node);
+	}
+	NLS_ASSERT(NLS_NODE_TABLE_INIT_SIZE < nls_node_table_num);
+	nls_node_table_sweep();
+	NLS_ASSERT(NLS_NODE_TABLE_INIT_SIZE / 2 > nls_node_table_num);
+
+	nls_node_intern(&same);
+	NLS_ASSERT_EQUALS(kept, same);
+	nls_release(kept);
+	nls_release(same);
+}
+#endif /* NLS_UNIT_TEST */
+
 int
 nls_list_add(nls_node *ent, nls_node *item)
 {
@@ -224,6 +721,7 @@ nls_list_add(nls_node *ent, nls_node *item)
 		return 1;
 	}
 	list->nl_rest = nls_grab(new);
+	nls_gc_write(tail);
 	return 0;
 }
 
@@ -271,6 +769,7 @@ nls_list_concat(nls_node *ent1, nls_node *ent2)
 	tail = nls_list_tail_entry(ent1);
 	list = &(tail->nn_list);
 	list->nl_rest = nls_grab(ent2);
+	nls_gc_write(tail);
 	return 0;
 }
 
@@ -324,10 +823,130 @@ _nls_node_new(nls_node_type_t type, nls_node_operations *op)
 		return NULL;
 	}
 	node->nn_type = type;
+	node->nn_hash = 0;
 	node->nn_op = op;
 	return node;
 }
 
+/* Hash of an interned node or an immediate. */
+#define NLS_NODE_HASH(node) \
+	(NLS_ISIMM(node) ? nls_node_hash(node) : (node)->nn_hash)
+
+/*
+ * Hash of a node whose parts are interned, never 0.
+ */
+static uint32_t
+nls_node_hash(nls_node *node)
+{
+	uint64_t hash = NLS_NODE_TYPE(node);
+
+	switch (NLS_NODE_TYPE(node)) {
+	case NLS_TYPE_INT:
+		hash = hash * 0x100000001b3ULL + (uint32_t)NLS_INT_VAL(node);
+		break;
+	case NLS_TYPE_VAR:
+		hash = hash * 0x100000001b3ULL + node->nn_var.nv_name->ns_hash;
+		hash = hash * 0x100000001b3ULL + (uint32_t)node->nn_var.nv_index;
+		break;
+	case NLS_TYPE_FUNCTION:
+		hash = hash * 0x100000001b3ULL + node->nn_func.nf_name->ns_hash;
+		break;
+	case NLS_TYPE_LIST:
+		hash = hash * 0x100000001b3ULL
+			+ NLS_NODE_HASH(node->nn_list.nl_head);
+		if (node->nn_list.nl_rest) {
+			hash = hash * 0x100000001b3ULL
+				+ node->nn_list.nl_rest->nn_hash;
+		}
+		break;
+	default:
+		break;
+	}
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	return (uint32_t)hash | 1;
+}
+
+/*
+ * Compare the contents of two nodes, but the parts of lists by address.
+ */
+static int
+nls_node_same(nls_node *node1, nls_node *node2)
+{
+	if (NLS_NODE_TYPE(node1) != NLS_NODE_TYPE(node2)) {
+		return 0;
+	}
+	switch (NLS_NODE_TYPE(node1)) {
+	case NLS_TYPE_INT:
+		return NLS_INT_VAL(node1) == NLS_INT_VAL(node2);
+	case NLS_TYPE_VAR:
+		/* nv_slot follows from the name. */
+		return node1->nn_var.nv_index == node2->nn_var.nv_index
+			&& !nls_strcmp(node1->nn_var.nv_name,
+				node2->nn_var.nv_name);
+	case NLS_TYPE_FUNCTION:
+		return node1->nn_func.nf_fp == node2->nn_func.nf_fp
+			&& node1->nn_func.nf_num_args
+				== node2->nn_func.nf_num_args;
+	case NLS_TYPE_LIST:
+		return node1->nn_list.nl_head == node2->nn_list.nl_head
+			&& node1->nn_list.nl_rest == node2->nn_list.nl_rest;
+	default:
+		return 0;
+	}
+}
+
+/*
+ * Table entry of the interned node equal to node, or the empty entry
+ * where it belongs.
+ */
+static nls_node**
+nls_node_table_find(nls_node *node, uint32_t hash)
+{
+	nls_node *ent;
+	size_t i, mask = nls_node_table_size - 1;
+
+	for (i = hash & mask; (ent = nls_node_table[i]); i = (i + 1) & mask) {
+		if (hash == ent->nn_hash && nls_node_same(node, ent)) {
+			break;
+		}
+	}
+	return &nls_node_table[i];
+}
+
+static int
+nls_node_table_rehash(size_t size)
+{
+	size_t i, old_size = nls_node_table_size;
+	nls_node **old = nls_node_table;
+
+	if (!(nls_node_table = calloc(size, sizeof(nls_node*)))) {
+		nls_node_table = old;
+		return ENOMEM;
+	}
+	nls_node_table_size = size;
+	for (i = 0; i < old_size; i++) {
+		if (old[i]) {
+			*nls_node_table_find(old[i], old[i]->nn_hash) = old[i];
+		}
+	}
+	free(old);
+	return 0;
+}
+
+#ifdef NLS_GC
+static void
+nls_node_table_trace(void)
+{
+	size_t i;
+
+	for (i = 0; i < nls_node_table_size; i++) {
+		nls_gc_visit(&nls_node_table[i]);
+	}
+}
+#endif /* NLS_GC */
+
 static void
 nls_list_item_free(nls_node *node)
 {
@@ -356,9 +975,90 @@ nls_list_tail_entry(nls_node *node)
 }
 
 static void
-nls_bound_vars(nls_node **tree, nls_node *var)
+nls_bound_vars(nls_node *tree, nls_node *vars, int depth)
+{
+	(NLS_NODE_OP(tree)->nop_bound_vars)(tree, vars, depth);
+}
+
+/**
+ * The body of the abstraction abst with args for all of its parameters,
+ * as applying it reduces to. abst is left as it is.
+ * @return Reference to the body, NULL if out of memory.
+ */
+nls_node*
+nls_abstraction_instantiate(nls_node *abst, nls_node *args)
 {
-	((*tree)->nn_op->nop_bound_vars)(tree, var);
+	nls_node *clone, *def;
+
+	if (!(clone = nls_node_clone(abst))) {
+		return NULL;
+	}
+	clone = nls_grab(clone);
+	nls_subst(&clone->nn_abst.nab_def, args, nls_list_count(args), 0);
+	def = nls_grab(clone->nn_abst.nab_def);
+	nls_release(clone);
+	return def;
+}
+
+/*
+ * Substitute args for the first n parameters of the abstraction
+ * depth parameters out, and renumber references to the rest.
+ */
+static void
+nls_subst(nls_node **tree, nls_node *args, int n, int depth)
+{
+	(NLS_NODE_OP(*tree)->nop_subst)(tree, args, n, depth);
+}
+
+/*
+ * Instantiate the items of a list, as nls_node_inst() does.
+ */
+static nls_node*
+nls_list_inst(nls_node *list, void *frame, int depth, nls_node_lookup lookup)
+{
+	int changed = 0;
+	nls_node **item, *tmp, *new = NULL;
+
+	nls_list_foreach(list, &item, &tmp) {
+		nls_node *inst = nls_node_inst(*item, frame, depth, lookup);
+
+		if (!inst) {
+			goto free_exit;
+		}
+		if (inst != *item) {
+			changed = 1;
+		}
+		if (!new) {
+			if (!(new = nls_list_new(inst))) {
+				nls_release(inst);
+				return NULL;
+			}
+			new = nls_grab(new);
+		} else if (nls_list_add(new, inst)) {
+			nls_release(inst);
+			goto free_exit;
+		}
+		nls_release(inst);
+	}
+	if (changed) {
+		return new;
+	}
+	nls_release(new);
+	return nls_grab(list);
+free_exit:
+	if (new) {
+		nls_release(new);
+	}
+	return NULL;
+}
+
+static nls_node*
+nls_list_nth(nls_node *list, int n)
+{
+	while (n--) {
+		list = list->nn_list.nl_rest;
+	}
+	return list->nn_list.nl_head;
 }
 
 static void
@@ -384,6 +1084,9 @@ nls_abstraction_release(nls_node *tree)
 {
 	nls_abstraction *abst = &(tree->nn_abst);
 
+	if (abst->nab_code) {
+		nls_closure_forget(tree);
+	}
 	nls_release(abst->nab_vars);
 	nls_release(abst->nab_def);
 }
@@ -406,19 +1109,19 @@ nls_list_release(nls_node *tree)
 static nls_node*
 nls_int_clone(nls_node *tree)
 {
-	return nls_int_new(tree->nn_int);
+	return nls_int_new(NLS_INT_VAL(tree));
 }
 
 static nls_node*
 nls_var_clone(nls_node *tree)
 {
-	nls_string *str = nls_string_new(tree->nn_var.nv_name->ns_bufp);
+	nls_node *node = nls_var_new(tree->nn_var.nv_name); /* Interned */
 
-	if (!str) {
-		NLS_ERROR(NLS_MSG_ENOMEM);
-		return NULL;
+	if (node) {
+		node->nn_var.nv_slot = tree->nn_var.nv_slot;
+		node->nn_var.nv_index = tree->nn_var.nv_index;
 	}
-	return nls_var_new(str);
+	return node;
 }
 
 static nls_node*
@@ -426,14 +1129,14 @@ nls_function_clone(nls_node *tree)
 {
 	nls_function *func = &(tree->nn_func);
 
-	return nls_function_new(func->nf_fp,
-		func->nf_num_args, func->nf_name->ns_bufp);
+	return nls_function_new(func->nf_fp, func->nf_num_args,
+		func->nf_strict, func->nf_name->ns_buf); /* Interned */
 }
 
 static nls_node*
 nls_abstraction_clone(nls_node *tree)
 {
-	nls_node *vars, *def;
+	nls_node *node, *vars, *def;
 	nls_abstraction *abst = &(tree->nn_abst);
 
 	if (!(vars = nls_node_clone(abst->nab_vars))) {
@@ -444,7 +1147,12 @@ nls_abstraction_clone(nls_node *tree)
 		NLS_ERROR(NLS_MSG_ENOMEM);
 		return NULL;
 	}
-	return nls_abstraction_new(vars, def);
+	/* Indices are cloned as they are: no need to bind again. */
+	if (!(node = nls_abstraction_new_bound(vars, def))) {
+		NLS_ERROR(NLS_MSG_ENOMEM);
+		return NULL;
+	}
+	return node;
 }
 
 static nls_node*
@@ -496,25 +1204,25 @@ nls_list_clone(nls_node *tree)
 void
 nls_node_print(nls_node *node, FILE* out)
 {
-	(node->nn_op->nop_print)(node, out);
+	(NLS_NODE_OP(node)->nop_print)(node, out);
 }
 
 static void
 nls_int_print(nls_node *node, FILE* out)
 {
-	fprintf(out, "%d", node->nn_int);
+	fprintf(out, "%d", NLS_INT_VAL(node));
 }
 
 static void
 nls_var_print(nls_node *node, FILE* out)
 {
-	fprintf(out, "%s", node->nn_var.nv_name->ns_bufp);
+	fprintf(out, "%s", node->nn_var.nv_name->ns_buf);
 }
 
 static void
 nls_function_print(nls_node *node, FILE* out)
 {
-	fprintf(out, "%s", node->nn_func.nf_name->ns_bufp);
+	fprintf(out, "%s", node->nn_func.nf_name->ns_buf);
 }
 
 static void
@@ -562,30 +1270,56 @@ nls_int_apply(nls_node **tree)
 static int
 nls_var_apply(nls_node **tree)
 {
+	int ret;
 	nls_node *tmp;
 	nls_application *app = &((*tree)->nn_app);
 	nls_node **func = &(app->nap_func);
 
-	if (!(tmp = nls_symbol_get((*func)->nn_var.nv_name))) {
+	if (!(tmp = nls_symbol_get(*func))) {
 		NLS_ERROR(NLS_MSG_NO_SUCH_SYMBOL ": %s",
-			(*func)->nn_var.nv_name->ns_bufp);
+			(*func)->nn_var.nv_name->ns_buf);
 		return EINVAL;
 	}
+	if (NLS_TYPE_ABSTRACTION == NLS_NODE_TYPE(tmp) && nls_symbol_hot(*func)) {
+		/* Hot: its compiled body runs instead of a substituted copy. */
+		if ((ret = nls_closure_eval(tree))) {
+			return ret;
+		}
+		/*
+		 * The value shares the parts of definitions left as they
+		 * are, which reductions would rewrite in place: copy it.
+		 */
+		if (!(tmp = nls_node_clone(*tree))) {
+			return ENOMEM;
+		}
+		tmp = nls_grab(tmp);
+		nls_release(*tree);
+		*tree = tmp;
+		return 0;
+	}
+	if (NLS_TYPE_ABSTRACTION == NLS_NODE_TYPE(tmp) && nls_sys_config.nc_fold &&
+		tmp->nn_abst.nab_num_args == nls_list_count(app->nap_args)) {
+		/* A partial call leaves the body to print: only a full one. */
+		tmp = nls_symbol_folded(*func);
+	}
 	nls_release(*func);
-	*func = nls_grab(nls_node_clone(tmp));
-	return nls_eval(tree);
+	if (NLS_TYPE_FUNCTION == NLS_NODE_TYPE(tmp)) {
+		/* Builtins are never rewritten by a reduction: borrow it. */
+		*func = nls_grab(tmp);
+	} else {
+		*func = nls_grab(nls_node_clone(tmp));
+	}
+	nls_gc_write(*tree);
+	return NLS_EVAL_AGAIN;
 }
 
-static int
-nls_function_apply(nls_node **tree)
+/**
+ * Call a builtin with args, or curry it when args are short.
+ * On entry, *out is as described for nls_fp.
+ */
+int
+nls_function_call(nls_node *func, nls_node *args, nls_node **out)
 {
-	int ret;
-	nls_node *out;
-
-	nls_application *app = &((*tree)->nn_app);
-	nls_node *func = app->nap_func;
-	nls_node *args = app->nap_args;
-
 	nls_fp fp = func->nn_func.nf_fp;
 	int nargs_expected = func->nn_func.nf_num_args;
 	int nargs_actual = nls_list_count(args);
@@ -596,15 +1330,26 @@ nls_function_apply(nls_node **tree)
 		return EINVAL;
 	}
 	if (nargs_actual < nargs_expected) {
-		if ((ret = nls_function_part_apply(func, args, &out))) {
-			return ret;
-		}
-		goto set_result_exit;
+		return nls_function_part_apply(func, args, out);
 	}
-	if ((ret = (fp)(args, &out))) {
+	return (fp)(args, out);
+}
+
+static int
+nls_function_apply(nls_node **tree)
+{
+	int ret;
+	nls_node *out;
+	nls_application *app = &((*tree)->nn_app);
+
+	/* A uniquely referenced application may be recycled as the result. */
+	out = nls_is_unique(*tree) ? *tree : NULL;
+	if ((ret = nls_function_call(app->nap_func, app->nap_args, &out))) {
 		return ret;
 	}
-set_result_exit:
+	if (out == *tree) {
+		return 0;
+	}
 	out = nls_grab(out);
 	nls_release(*tree);
 	*tree = out;
@@ -622,7 +1367,6 @@ nls_abstraction_apply(nls_node **tree)
 	nls_node *args = app->nap_args;
 
 	nls_abstraction *abst = &(func->nn_abst);
-	nls_node *vars = abst->nab_vars;
 	int nargs_expected = abst->nab_num_args;
 	int nargs_actual = nls_list_count(args);
 
@@ -632,22 +1376,22 @@ nls_abstraction_apply(nls_node **tree)
 		return EINVAL;
 	}
 
-	nls_replace_vars(vars, args);
+	nls_subst(&abst->nab_def, args, nargs_actual, 0);
+	nls_gc_write(func);
 	if (nargs_actual < nargs_expected) {
 		/* Partial apply */
 		nls_remove_head_vars(func, nargs_actual);
 		out = func;
-		goto set_result_exit;
+		ret = 0;
+	} else {
+		/* The body replaces the application, for the caller to reduce. */
+		out = abst->nab_def;
+		ret = NLS_EVAL_AGAIN;
 	}
-	if ((ret = nls_eval(&abst->nab_def))) {
-		return ret;
-	}
-	out = abst->nab_def;
-set_result_exit:
 	out = nls_grab(out);
 	nls_release(*tree);
 	*tree = out;
-	return 0;
+	return ret;
 }
 
 static int
@@ -660,7 +1404,8 @@ nls_application_apply(nls_node **tree)
 	if ((ret = nls_eval(func))) {
 		return ret;
 	}
-	return nls_eval(tree);
+	nls_gc_write(*tree);
+	return NLS_ISAPP(*func) ? 0 : NLS_EVAL_AGAIN;
 }
 
 static int
@@ -671,61 +1416,127 @@ nls_list_apply(nls_node **tree)
 }
 
 static void
-nls_int_bound_vars(nls_node **tree, nls_node *var)
+nls_int_bound_vars(nls_node *tree, nls_node *vars, int depth)
 {
 	/* Nothing to do. */
 }
 
 static void
-nls_var_bound_vars(nls_node **tree, nls_node *var)
+nls_var_bound_vars(nls_node *tree, nls_node *vars, int depth)
 {
-	if (!nls_strcmp((*tree)->nn_var.nv_name, var->nn_var.nv_name)) {
-		nls_node **next_ref = var->nn_var.nv_next_ref;
+	int i = 0;
+	nls_node **var, *tmp;
 
-		(*tree)->nn_var.nv_next_ref = next_ref;
-		var->nn_var.nv_next_ref = tree;
+	if (0 <= tree->nn_var.nv_index) {
+		return; /* Bound by an inner abstraction. */
+	}
+	nls_list_foreach(vars, &var, &tmp) {
+		if (NLS_ISVAR(*var) &&
+			!nls_strcmp(tree->nn_var.nv_name, (*var)->nn_var.nv_name)) {
+			tree->nn_var.nv_index = depth + i;
+			return;
+		}
+		i++;
 	}
 }
 
 static void
-nls_function_bound_vars(nls_node **tree, nls_node *var)
+nls_function_bound_vars(nls_node *tree, nls_node *vars, int depth)
 {
 	/* Nothing to do. */
 }
 
 static void
-nls_abstraction_bound_vars(nls_node **tree, nls_node *var)
+nls_abstraction_bound_vars(nls_node *tree, nls_node *vars, int depth)
 {
-	nls_bound_vars(&((*tree)->nn_abst.nab_vars), var);
-	nls_bound_vars(&((*tree)->nn_abst.nab_def), var);
+	nls_abstraction *abst = &(tree->nn_abst);
+
+	nls_bound_vars(abst->nab_def, vars, depth + abst->nab_num_args);
 }
 
 static void
-nls_application_bound_vars(nls_node **tree, nls_node *var)
+nls_application_bound_vars(nls_node *tree, nls_node *vars, int depth)
 {
-	nls_bound_vars(&((*tree)->nn_app.nap_args), var);
+	nls_bound_vars(tree->nn_app.nap_args, vars, depth);
 }
 
 static void
-nls_list_bound_vars(nls_node **tree, nls_node *var)
+nls_list_bound_vars(nls_node *tree, nls_node *vars, int depth)
 {
 	nls_node **item, *tmp;
 
-	nls_list_foreach((*tree), &item, &tmp) {
-		nls_bound_vars(item, var);
+	nls_list_foreach(tree, &item, &tmp) {
+		nls_bound_vars(*item, vars, depth);
 	}
 }
 
+static void
+nls_int_subst(nls_node **tree, nls_node *args, int n, int depth)
+{
+	/* Nothing to do. */
+}
+
+static void
+nls_var_subst(nls_node **tree, nls_node *args, int n, int depth)
+{
+	nls_node *var = *tree;
+	int i = var->nn_var.nv_index - depth;
+
+	if (i < 0) {
+		return; /* Free, or bound by an inner abstraction. */
+	}
+	if (i >= n) {
+		var->nn_var.nv_index -= n;
+		return;
+	}
+	*tree = nls_grab(nls_list_nth(args, i));
+	nls_release(var);
+}
+
+static void
+nls_function_subst(nls_node **tree, nls_node *args, int n, int depth)
+{
+	/* Nothing to do. */
+}
+
+static void
+nls_abstraction_subst(nls_node **tree, nls_node *args, int n, int depth)
+{
+	nls_abstraction *abst = &((*tree)->nn_abst);
+
+	nls_subst(&abst->nab_def, args, n, depth + abst->nab_num_args);
+	nls_gc_write(*tree);
+}
+
+static void
+nls_application_subst(nls_node **tree, nls_node *args, int n, int depth)
+{
+	nls_subst(&((*tree)->nn_app.nap_args), args, n, depth);
+}
+
+static void
+nls_list_subst(nls_node **tree, nls_node *args, int n, int depth)
+{
+	nls_node *cell;
+
+	for (cell = *tree; cell; cell = cell->nn_list.nl_rest) {
+		nls_subst(&cell->nn_list.nl_head, args, n, depth);
+		nls_gc_write(cell);
+	}
+}
+
+/*
+ * Wrap func(args) into lambda(x1 .. xn).func(args x1 .. xn).
+ * If *out is set, it is the application func(args) itself and
+ * becomes the body of the result.
+ */
 static int
 nls_function_part_apply(nls_node *func, nls_node *args, nls_node **out)
 {
-	int num_args     = func->nn_func.nf_num_args;
-	nls_string *name = func->nn_func.nf_name;
-	nls_fp fp        = func->nn_func.nf_fp;
-
-	nls_node *vars, *add_vars;
+	int i = 0;
+	nls_node *vars, *add_vars, **var, *tmp;
 	nls_node *def, *curry;
-	int num_lack = num_args - nls_list_count(args);
+	int num_lack = func->nn_func.nf_num_args - nls_list_count(args);
 
 	vars = nls_vars_new(num_lack);
 	if (!vars) {
@@ -736,22 +1547,22 @@ nls_function_part_apply(nls_node *func, nls_node *args, nls_node **out)
 		nls_node_free(vars);
 		return ENOMEM;
 	}
-	func = nls_function_new(fp, num_args, name->ns_bufp);
-	if (!func) {
-		nls_node_free(vars);
-		nls_node_free(add_vars);
-		return ENOMEM;
+	/* Bound right away: binding by name could also catch args. */
+	nls_list_foreach(add_vars, &var, &tmp) {
+		(*var)->nn_var.nv_index = i++;
 	}
 	nls_list_concat(args, add_vars);
-	def = nls_application_new(func, args);
+	/* Builtins are immutable, so the body shares func. */
+	def = *out ? *out : nls_application_new(func, args);
 	if (!def) {
-		nls_node_free(func);
 		nls_node_free(vars);
 		return ENOMEM;
 	}
-	curry = nls_abstraction_new(vars, def);
+	curry = nls_abstraction_new_bound(vars, def);
 	if (!curry) {
-		nls_node_free(def);
+		if (def != *out) {
+			nls_node_free(def);
+		}
 		nls_node_free(vars);
 		return ENOMEM;
 	}
@@ -759,24 +1570,6 @@ nls_function_part_apply(nls_node *func, nls_node *args, nls_node **out)
 	return 0;
 }
 
-static void
-nls_replace_vars(nls_node *vars, nls_node *args)
-{
-	nls_node **var, **arg, *tmp1, *tmp2;
-
-	nls_double_list_foreach(vars, args, &var, &arg, &tmp1, &tmp2) {
-		nls_node **replace = (*var)->nn_var.nv_next_ref;
-		nls_node **next = replace ?(*replace)->nn_var.nv_next_ref : NULL;
-
-		while (replace) {
-			nls_release(*replace);
-			*replace = nls_grab(*arg);
-			replace = next;
-			next = next ? (*next)->nn_var.nv_next_ref : NULL;
-		}
-	}
-}
-
 static void
 nls_remove_head_vars(nls_node *func, int n)
 {
@@ -787,6 +1580,7 @@ nls_remove_head_vars(nls_node *func, int n)
 	for (i = 0; i < n; i++) {
 		nls_list_remove(vars);
 	}
+	nls_gc_write(func);
 	abst->nab_num_args -= n;
 }
 
@@ -804,13 +1598,12 @@ nls_vars_new(int n)
 		nls_string *name;
 
 		snprintf(bufp, NLS_ANON_VAR_NAME_BUF_SIZE-1, "%d", i);
-		name = nls_string_new(buf);
+		name = nls_string_intern(buf);
 		if (!name) {
 			goto free_exit;
 		}
 		var = nls_var_new(name);
 		if (!var) {
-			nls_string_free(name);
 			goto free_exit;
 		}
 		if (!vars) {
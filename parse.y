@@ -25,8 +25,12 @@
 #include "nameless/function.h"
 
 NLS_GLOBAL nls_node *nls_sys_parse_result;
+NLS_GLOBAL nls_parse_hook nls_sys_parse_hook;
+
+static nls_node *nls_prog_tail; /* Last entry of the program parsed */
 
 static int yyerror(char *msg);
+static int nls_prog_add(nls_node *prog, nls_node *expr, nls_node **out);
 %}
 
 %union {
@@ -42,7 +46,7 @@ static int yyerror(char *msg);
 %token<yst_int> tNUMBER
 %token<yst_str> tIDENT
 
-%type<yst_node> code exprs
+%type<yst_node> code prog exprs
 %type<yst_node> expr abstraction
 
 %start code
@@ -52,10 +56,23 @@ code	: op_spaces
 	{
 		nls_sys_parse_result = $$ = NULL;
 	}
-	| op_spaces exprs op_spaces
+	| op_spaces prog op_spaces
 	{
 		$$ = $2;
-		nls_sys_parse_result = nls_grab($$);
+		nls_sys_parse_result = $$ ? nls_grab($$) : NULL;
+	}
+
+prog	: expr
+	{
+		if (nls_prog_add(NULL, $1, &$$)) {
+			YYABORT;
+		}
+	}
+	| prog spaces expr
+	{
+		if (nls_prog_add($1, $3, &$$)) {
+			YYABORT;
+		}
 	}
 
 exprs	: expr
@@ -121,3 +138,34 @@ yyerror(char *msg)
 
 	return 0;
 }
+
+/*
+ * Append a top-level expression, or hand it to nls_sys_parse_hook as
+ * soon as it is complete, leaving the program NULL. When interning, its
+ * immutable parts are shared with those parsed before right away, so
+ * duplicates never pile up over a long program.
+ * @retval 0    Added.
+ * @retval else Error code of the hook, to stop parsing with.
+ */
+static int
+nls_prog_add(nls_node *prog, nls_node *expr, nls_node **out)
+{
+	expr = nls_grab(expr);
+	if (nls_sys_config.nc_intern) {
+		nls_node_intern(&expr);
+	}
+	if (nls_sys_parse_hook) {
+		/* The reference is the hook's: reductions rewrite it in place. */
+		*out = NULL;
+		return (nls_sys_parse_hook)(expr);
+	}
+	if (!prog) {
+		prog = nls_prog_tail = nls_list_new(expr);
+	} else {
+		nls_list_add(nls_prog_tail, expr);
+		nls_prog_tail = nls_prog_tail->nn_list.nl_rest;
+	}
+	nls_release(expr); /* Held by prog now. */
+	*out = prog;
+	return 0;
+}
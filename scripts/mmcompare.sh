@@ -0,0 +1,54 @@
+#!/bin/sh
+
+#
+# Nameless - A lambda calculation language.
+# Copyright (C) 2009 Yoshifumi Shimono <yoshifumi.shimono@gmail.com>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+#
+# Run the test suite ROUNDS times on each executable and report the
+# elapsed time and the largest peak RSS seen.
+#
+
+set -u
+
+if [ 1 -gt $# ]; then
+	echo "usage: `basename $0` exec..." 1>&2
+	exit 1
+fi
+
+ROUNDS=${ROUNDS:-20}
+TESTDIR=${TESTDIR:-test}
+STAT=`mktemp`
+trap 'rm -f $STAT' EXIT
+
+for EXEC in "$@"; do
+	RSS=0
+	START=`date +%s%N`
+	I=0
+	while [ $I -lt $ROUNDS ]; do
+		for T in $TESTDIR/*.nls; do
+			$EXEC -s < $T > /dev/null 2> $STAT
+			R=`sed -n 's/^peak rss: \([0-9]*\) KB$/\1/p' $STAT`
+			if [ -n "$R" ] && [ $RSS -lt $R ]; then
+				RSS=$R
+			fi
+		done
+		I=`expr $I + 1`
+	done
+	END=`date +%s%N`
+	echo "$EXEC: `expr \( $END - $START \) / 1000000` ms, peak rss $RSS KB"
+done
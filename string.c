@@ -16,46 +16,193 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <stdint.h>
+#include <stdlib.h>
 #include <errno.h>
 #include <string.h>
 #include "nameless/mm.h"
 #include "nameless/string.h"
 
-static size_t nls_strnlen_hash(char *str, size_t n, int *hashp);
+/*
+ * Identifiers are interned: the table holds one reference to a single
+ * nls_string per distinct name until nls_string_table_term(), so equal
+ * interned strings are always the same object.
+ */
+static nls_string **nls_string_table;
+static size_t nls_string_table_num;
+static size_t nls_string_table_size;
+
+#define NLS_STRING_TABLE_INIT_SIZE 256
+
+static size_t nls_strnlen_hash(char *str, size_t n, uint64_t *hashp);
+static int nls_string_table_grow(void);
+#ifdef NLS_GC
+static void nls_string_table_trace(void);
+#endif /* NLS_GC */
 
 nls_string*
 nls_string_new(char *s)
 {
-	int hash;
-	char *buf;
+	uint64_t hash;
 	nls_string *str;
 	size_t len = nls_strnlen_hash(s, SIZE_MAX-1, &hash);
 
-	if (!(buf = nls_array_new(char, len+1))) {
+	/* The characters follow the header in the same chunk. */
+	if (!(str = nls_new_ext(nls_string, len+1))) {
 		return NULL;
 	}
-	if (!(str = nls_new(nls_string))) {
-		if (buf) {
-			nls_free(buf);
+	strncpy(str->ns_buf, s, len);
+	str->ns_buf[len] = '\0';
+	str->ns_len  = len;
+	str->ns_hash = hash;
+	str->ns_interned = 0;
+	str->ns_next = NULL;
+	return str;
+}
+
+/**
+ * Get the interned string equal to s, creating it on first use.
+ * Interned strings live on the heap even while an arena is active.
+ */
+nls_string*
+nls_string_intern(char *s)
+{
+	uint64_t hash;
+	nls_string *str, **head;
+	size_t len = nls_strnlen_hash(s, SIZE_MAX-1, &hash);
+
+	if (nls_string_table_size) {
+		head = &nls_string_table[hash & (nls_string_table_size - 1)];
+		for (str = *head; str; str = str->ns_next) {
+			if (hash == str->ns_hash && len == str->ns_len
+				&& !strncmp(s, str->ns_buf, len)) {
+				return str;
+			}
 		}
+	}
+	if (nls_string_table_num >= nls_string_table_size
+		&& nls_string_table_grow()) {
 		return NULL;
 	}
-	strncpy(buf, s, len);
-	buf[len] = '\0';
-	str->ns_len  = len;
-	str->ns_hash = hash;
-	str->ns_bufp = nls_grab(buf);
+	nls_arena_suspend();
+	str = nls_string_new(s);
+	nls_arena_resume();
+	if (!str) {
+		return NULL;
+	}
+	str->ns_interned = 1;
+	head = &nls_string_table[hash & (nls_string_table_size - 1)];
+	str->ns_next = *head;
+	*head = nls_grab(str);
+	nls_string_table_num++;
 	return str;
 }
 
+#ifdef NLS_UNIT_TEST
+static void
+test_nls_string_intern(void)
+{
+	nls_string *str1 = nls_string_intern("abc");
+	nls_string *str2 = nls_string_intern("abc");
+	nls_string *str3 = nls_string_intern("cba"); /* Anagram */
+	nls_string *str4 = nls_string_new("abc");
+
+	NLS_ASSERT_EQUALS(str1, str2);
+	NLS_ASSERT_NOT_EQUALS(str1, str3);
+	NLS_ASSERT_EQUALS(0, nls_strcmp(str1, str2));
+	NLS_ASSERT_NOT_EQUALS(0, nls_strcmp(str1, str3));
+	NLS_ASSERT_EQUALS(0, nls_strcmp(str1, str4));
+	nls_string_free(str4);
+}
+#endif /* NLS_UNIT_TEST */
+
+/*
+ * Double the number of chains, keeping at most one string per chain
+ * on average.
+ */
+static int
+nls_string_table_grow(void)
+{
+	size_t i, size;
+	nls_string **table, *str, *next;
+
+	size = nls_string_table_size ? 2 * nls_string_table_size
+		: NLS_STRING_TABLE_INIT_SIZE;
+	if (!(table = calloc(size, sizeof(nls_string*)))) {
+		return ENOMEM;
+	}
+	for (i = 0; i < nls_string_table_size; i++) {
+		for (str = nls_string_table[i]; str; str = next) {
+			nls_string **head = &table[str->ns_hash & (size - 1)];
+
+			next = str->ns_next;
+			str->ns_next = *head;
+			nls_gc_write(str);
+			*head = str;
+		}
+	}
+	free(nls_string_table);
+	nls_string_table = table;
+	nls_string_table_size = size;
+	return 0;
+}
+
+void
+nls_string_table_init(void)
+{
+	nls_string_table = NULL; /* Allocated by the first nls_string_intern(). */
+	nls_string_table_num  = 0;
+	nls_string_table_size = 0;
+#ifdef NLS_GC
+	nls_gc_root_add(nls_string_table_trace);
+#endif /* NLS_GC */
+}
+
+void
+nls_string_table_term(void)
+{
+	size_t i;
+
+	for (i = 0; i < nls_string_table_size; i++) {
+		nls_string *str, *next;
+
+		for (str = nls_string_table[i]; str; str = next) {
+			next = str->ns_next;
+			nls_release(str);
+		}
+	}
+	free(nls_string_table);
+	nls_string_table = NULL;
+	nls_string_table_num  = 0;
+	nls_string_table_size = 0;
+}
+
+#ifdef NLS_GC
+static void
+nls_string_table_trace(void)
+{
+	size_t i;
+
+	for (i = 0; i < nls_string_table_size; i++) {
+		nls_gc_visit(&nls_string_table[i]);
+	}
+}
+#endif /* NLS_GC */
+
 void
 nls_string_free(void *ptr)
+{
+	nls_free(ptr);
+}
+
+#ifdef NLS_GC
+void
+nls_string_trace(void *ptr)
 {
 	nls_string *str = (nls_string*)ptr;
 
-	nls_release(str->ns_bufp);
-	nls_free(str);
+	nls_gc_visit(&str->ns_next);
 }
+#endif /* NLS_GC */
 
 #ifdef NLS_UNIT_TEST
 static void
@@ -92,28 +239,48 @@ test_nls_string_free(void)
 }
 #endif /* NLS_UNIT_TEST */
 
+/**
+ * Compare two strings. The result is only meaningful as equal (0) or not:
+ * two distinct interned strings differ, and are ordered by address.
+ */
 int
 nls_strcmp(nls_string *s1, nls_string *s2)
 {
+	if (s1 == s2) {
+		return 0;
+	}
+	if (s1->ns_interned && s2->ns_interned) {
+		return (s1 < s2) ? -1 : 1;
+	}
 	if (s1->ns_hash != s2->ns_hash) {
-		return s1->ns_hash - s2->ns_hash;
+		return (s1->ns_hash < s2->ns_hash) ? -1 : 1;
 	}
 	if (s1->ns_len != s2->ns_len) {
 		return s1->ns_len - s2->ns_len;
 	}
-	return strncmp(s1->ns_bufp, s2->ns_bufp, s1->ns_len);
+	return strncmp(s1->ns_buf, s2->ns_buf, s1->ns_len);
 }
 
+/*
+ * Length and 64-bit hash of at most n characters: FNV-1a, then the
+ * MurmurHash3 finalizer so that the low bits used to index the tables
+ * depend on every input byte.
+ */
 static size_t
-nls_strnlen_hash(char *str, size_t n, int *hashp)
+nls_strnlen_hash(char *str, size_t n, uint64_t *hashp)
 {
 	size_t i;
-	int hash = 0;
+	uint64_t hash = 0xcbf29ce484222325ULL;
 
 	for (i = 0; (i < n) && ('\0' != *str); i++, str++) {
-		hash += *str;
-		hash %= NLS_HASH_WIDTH;
+		hash ^= (unsigned char)*str;
+		hash *= 0x100000001b3ULL;
 	}
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53ULL;
+	hash ^= hash >> 33;
 	*hashp = hash;
 	return i;
 }
@@ -122,27 +289,29 @@ nls_strnlen_hash(char *str, size_t n, int *hashp)
 static void
 test_nls_strnlen_hash_when_empty(void)
 {
-	int hash;
+	uint64_t hash, hash0;
 	size_t len = nls_strnlen_hash("", 10, &hash);
 
+	nls_strnlen_hash("x", 0, &hash0);
 	NLS_ASSERT_EQUALS(0, len);
-	NLS_ASSERT_EQUALS(0, hash);
+	NLS_ASSERT_EQUALS(hash0, hash);
 }
 
 static void
 test_nls_strnlen_hash_when_length1(void)
 {
-	int hash;
-	size_t len = nls_strnlen_hash("x", 10, &hash);
+	uint64_t hash1, hash2;
+	size_t len = nls_strnlen_hash("x", 10, &hash1);
 
+	nls_strnlen_hash("xyz", 1, &hash2);
 	NLS_ASSERT_EQUALS(1, len);
-	NLS_ASSERT_EQUALS(('x' % NLS_HASH_WIDTH), hash);
+	NLS_ASSERT_EQUALS(hash1, hash2);
 }
 
 static void
 test_nls_strnlen_hash_differ(void)
 {
-	int hash1, hash2;
+	uint64_t hash1, hash2;
 
 	nls_strnlen_hash("a", 10, &hash1);
 	nls_strnlen_hash("b", 10, &hash2);
@@ -184,20 +353,19 @@ test_nls_strnlen_hash_differ(void)
 static void
 test_nls_strnlen_hash_when_normal(void)
 {
-	int hash, hash1, hash2;
-	size_t len  = nls_strnlen_hash("abc", 10, &hash);
+	uint64_t hash1, hash2;
+	size_t len = nls_strnlen_hash("abc", 10, &hash1);
 
-	nls_strnlen_hash("a",   10, &hash1);
-	nls_strnlen_hash("bc",  10, &hash2);
+	nls_strnlen_hash("cba", 10, &hash2);
 
 	NLS_ASSERT_EQUALS(3, len);
-	NLS_ASSERT_EQUALS(hash, (hash1 + hash2) % NLS_HASH_WIDTH);
+	NLS_ASSERT_NOT_EQUALS(hash1, hash2); /* Order matters. */
 }
 
 static void
 test_nls_strnlen_hash_when_over_limit(void)
 {
-	int hash1, hash2;
+	uint64_t hash1, hash2;
 	size_t len1 = nls_strnlen_hash("ABCDEF", 5, &hash1);
 	size_t len2 = nls_strnlen_hash("ABCDE",  5, &hash2);
 
@@ -209,22 +377,23 @@ test_nls_strnlen_hash_when_over_limit(void)
 static void
 test_nls_strnlen_hash_when_long(void)
 {
-	int hash1, hash2, hash3;
+	uint64_t hash1, hash2;
 
 	nls_strnlen_hash("WXYZabcDEFqpo", 30, &hash1);
-	nls_strnlen_hash("WXYZ",          30, &hash2);
-	nls_strnlen_hash("abcDEFqpo",     30, &hash3);
+	nls_strnlen_hash("WXYZqpoDEFabc", 30, &hash2);
 
-	NLS_ASSERT_EQUALS(hash1, (hash2 + hash3) % NLS_HASH_WIDTH);
+	NLS_ASSERT_NOT_EQUALS(hash1, hash2);
+	NLS_ASSERT_NOT_EQUALS(hash1 & 0xff, hash2 & 0xff);
 }
 
 static void
 test_nls_strnlen_hash_when_limit_zero(void)
 {
-	int hash;
-	size_t len = nls_strnlen_hash("x", 0, &hash);
+	uint64_t hash1, hash2;
+	size_t len = nls_strnlen_hash("x", 0, &hash1);
 
+	nls_strnlen_hash("", 10, &hash2);
 	NLS_ASSERT_EQUALS(0, len);
-	NLS_ASSERT_EQUALS(0, hash);
+	NLS_ASSERT_EQUALS(hash2, hash1);
 }
 #endif /* NLS_UNIT_TEST */
@@ -0,0 +1,368 @@
+/*
+ * Nameless - A lambda calculation language.
+ * Copyright (C) 2009 Yoshifumi Shimono <yoshifumi.shimono@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdlib.h>
+#include <errno.h>
+#include "nameless.h"
+#include "nameless/mm.h"
+#include "nameless/hash.h"
+
+#define NLS_MSG_HASH_ENOENT "No such hash entry"
+
+/*
+ * Open addressing with linear probing over a power of 2 number of slots.
+ * The table doubles before it gets more than 3/4 full, and removal
+ * shifts the following entries back instead of leaving tombstones.
+ */
+#define NLS_HASH_INIT_SIZE 64
+#define NLS_HASH_FULL(hash) (3 * (hash)->nh_size < 4 * ((hash)->nh_num + 1))
+
+static nls_hash_entry* nls_hash_entry_new(nls_string *key, nls_node *node);
+#ifdef NLS_GC
+static void nls_hash_entry_trace(void *ptr);
+#else
+static void nls_hash_entry_free(void *ptr);
+#endif /* NLS_GC */
+static size_t nls_hash_slot(nls_hash *hash, nls_string *key);
+static int nls_hash_grow(nls_hash *hash);
+
+void
+nls_hash_init(nls_hash *hash)
+{
+	hash->nh_num  = 0;
+	hash->nh_size = 0;
+	hash->nh_table = NULL; /* Allocated by the first nls_hash_add(). */
+}
+
+void
+nls_hash_term(nls_hash *hash)
+{
+	size_t i;
+
+	for (i = 0; i < hash->nh_size; i++) {
+		if (hash->nh_table[i]) {
+			nls_release(hash->nh_table[i]);
+		}
+	}
+	free(hash->nh_table);
+	nls_hash_init(hash);
+}
+
+#ifdef NLS_GC
+/**
+ * Visit the entries of a hash as GC roots.
+ */
+void
+nls_hash_trace(nls_hash *hash)
+{
+	size_t i;
+
+	for (i = 0; i < hash->nh_size; i++) {
+		nls_gc_visit(&hash->nh_table[i]);
+	}
+}
+#endif /* NLS_GC */
+
+/**
+ * Search for hash.
+ * @param[in]  hash  Target hash pointer
+ * @param[in]  key   Search key
+ * @return !NULL Hash entry found
+ * @return  NULL No such entry
+ */
+nls_hash_entry*
+nls_hash_search(nls_hash *hash, nls_string *key)
+{
+	if (!hash->nh_size) {
+		return NULL;
+	}
+	return hash->nh_table[nls_hash_slot(hash, key)];
+}
+
+/**
+ * Add an entry, or replace the item of the entry with the same key.
+ * The replaced item is released.
+ */
+int
+nls_hash_add(nls_hash *hash, nls_string *key, nls_node *item)
+{
+	size_t i;
+	nls_hash_entry *ent;
+
+	if (hash->nh_size) {
+		i = nls_hash_slot(hash, key);
+		if ((ent = hash->nh_table[i])) {
+			nls_node *old = ent->nhe_node;
+
+			ent->nhe_node = nls_grab(item);
+			nls_gc_write(ent);
+			nls_release(old);
+			return 0;
+		}
+	}
+	if (NLS_HASH_FULL(hash) && nls_hash_grow(hash)) {
+		return ENOMEM;
+	}
+	if (!(ent = nls_hash_entry_new(key, item))) {
+		return ENOMEM;
+	}
+	hash->nh_table[nls_hash_slot(hash, key)] = nls_grab(ent);
+	hash->nh_num++;
+	return 0;
+}
+
+#ifdef NLS_UNIT_TEST
+static void
+test_nls_hash_add(void)
+{
+	nls_hash hash;
+	nls_string *key1 = nls_grab(nls_string_new("key1"));
+	nls_string *key2 = nls_grab(nls_string_new("KEY2"));
+	nls_node *item1 = nls_grab(nls_int_new(1));
+	nls_node *item2 = nls_grab(nls_int_new(2));
+
+	nls_hash_init(&hash);
+	NLS_ASSERT_EQUALS(0, hash.nh_num);
+	nls_hash_add(&hash, key1, item1);
+	NLS_ASSERT_EQUALS(1, hash.nh_num);
+	nls_hash_add(&hash, key2, item2);
+	NLS_ASSERT_EQUALS(2, hash.nh_num);
+
+	nls_release(key1);
+	nls_release(key2);
+	nls_release(item1);
+	nls_release(item2);
+	nls_hash_term(&hash);
+}
+
+static void
+test_nls_hash_add_replace(void)
+{
+	int i;
+	size_t size;
+	unsigned long live;
+	nls_hash hash;
+	nls_string *key = nls_grab(nls_string_new("acc"));
+
+	/* Boxed: an immediate would not show the replaced value leaking. */
+	nls_hash_init(&hash);
+	nls_hash_add(&hash, key, nls_int_box(0));
+	size = hash.nh_size;
+	live = nls_mem_live();
+	for (i = 1; i <= 100000; i++) {
+		nls_hash_add(&hash, key, nls_int_box(i));
+	}
+	NLS_ASSERT_EQUALS(1, hash.nh_num);
+	NLS_ASSERT_EQUALS(size, hash.nh_size);
+	NLS_ASSERT_EQUALS(live, nls_mem_live());
+	NLS_ASSERT_EQUALS(100000, NLS_INT_VAL(nls_hash_search(&hash, key)->nhe_node));
+
+	nls_release(key);
+	nls_hash_term(&hash);
+}
+
+static void
+test_nls_hash_add_many(void)
+{
+	int i;
+	char buf[16];
+	nls_hash hash;
+	nls_hash_entry *ent;
+
+	nls_hash_init(&hash);
+	for (i = 0; i < 1000; i++) {
+		snprintf(buf, sizeof(buf), "k%d", i);
+		nls_hash_add(&hash, nls_string_new(buf), nls_int_new(i));
+	}
+	NLS_ASSERT_EQUALS(1000, hash.nh_num);
+	NLS_ASSERT(4 * hash.nh_num <= 3 * hash.nh_size);
+	for (i = 0; i < 1000; i += 2) {
+		nls_string *key;
+
+		snprintf(buf, sizeof(buf), "k%d", i);
+		key = nls_grab(nls_string_new(buf));
+		nls_hash_remove(&hash, key);
+		nls_release(key);
+	}
+	NLS_ASSERT_EQUALS(500, hash.nh_num);
+	for (i = 0; i < 1000; i++) {
+		nls_string *key;
+
+		snprintf(buf, sizeof(buf), "k%d", i);
+		key = nls_grab(nls_string_new(buf));
+		ent = nls_hash_search(&hash, key);
+		if (i % 2) {
+			NLS_ASSERT(ent && i == NLS_INT_VAL(ent->nhe_node));
+		} else {
+			NLS_ASSERT_EQUALS(NULL, ent);
+		}
+		nls_release(key);
+	}
+	nls_hash_term(&hash);
+}
+#endif /* NLS_UNIT_TEST */
+
+int
+nls_hash_remove(nls_hash *hash, nls_string *key)
+{
+	size_t i, j, home, mask;
+	nls_hash_entry *ent = nls_hash_search(hash, key);
+
+	if (!ent) {
+		NLS_ERROR(NLS_MSG_HASH_ENOENT);
+		return EINVAL;
+	}
+	i = nls_hash_slot(hash, key);
+	nls_release(ent);
+	hash->nh_table[i] = NULL;
+	hash->nh_num--;
+
+	/* Move back entries that probed past the freed slot. */
+	mask = hash->nh_size - 1;
+	for (j = (i + 1) & mask; (ent = hash->nh_table[j]); j = (j + 1) & mask) {
+		home = ent->nhe_key->ns_hash & mask;
+		if ((i < j) ? (i < home && home <= j) : (i < home || home <= j)) {
+			continue;
+		}
+		hash->nh_table[i] = ent;
+		hash->nh_table[j] = NULL;
+		i = j;
+	}
+	return 0;
+}
+
+#ifdef NLS_UNIT_TEST
+static void
+test_nls_hash_remove(void)
+{
+	nls_hash hash;
+	nls_string *key1 = nls_grab(nls_string_new("WWW"));
+	nls_string *key2 = nls_grab(nls_string_new("912"));
+	nls_node *item1 = nls_grab(nls_int_new(1));
+	nls_node *item2 = nls_grab(nls_int_new(2));
+
+	nls_hash_init(&hash);
+	nls_hash_add(&hash, key1, item1);
+	nls_hash_add(&hash, key2, item2);
+
+	NLS_ASSERT_EQUALS(2, hash.nh_num);
+	nls_hash_remove(&hash, key1);
+	NLS_ASSERT_EQUALS(1, hash.nh_num);
+	nls_hash_remove(&hash, key2);
+	NLS_ASSERT_EQUALS(0, hash.nh_num);
+
+	nls_release(key1);
+	nls_release(key2);
+	nls_release(item1);
+	nls_release(item2);
+	nls_hash_term(&hash);
+}
+#endif /* NLS_UNIT_TEST */
+
+static nls_hash_entry*
+nls_hash_entry_new(nls_string *key, nls_node *node)
+{
+	nls_hash_entry *new = nls_new(nls_hash_entry);
+
+	if (!new) {
+		return NULL;
+	}
+	new->nhe_key  = nls_grab(key);
+	new->nhe_node = nls_grab(node);
+	return new;
+}
+
+#ifdef NLS_GC
+static void
+nls_hash_entry_trace(void *ptr)
+{
+	nls_hash_entry *ent = (nls_hash_entry*)ptr;
+
+	nls_gc_visit(&ent->nhe_key);
+	nls_gc_visit(&ent->nhe_node);
+}
+#else
+static void
+nls_hash_entry_free(void *ptr)
+{
+	nls_hash_entry *ent = (nls_hash_entry*)ptr;
+
+	nls_release(ent->nhe_key);
+	nls_release(ent->nhe_node);
+	nls_free(ent);
+}
+#endif /* NLS_GC */
+
+/*
+ * Index of the slot holding key, or of the empty slot ending its probe.
+ */
+static size_t
+nls_hash_slot(nls_hash *hash, nls_string *key)
+{
+	nls_hash_entry *ent;
+	size_t mask = hash->nh_size - 1;
+	size_t i = key->ns_hash & mask;
+
+	while ((ent = hash->nh_table[i]) && nls_strcmp(key, ent->nhe_key)) {
+		i = (i + 1) & mask;
+	}
+	return i;
+}
+
+static int
+nls_hash_grow(nls_hash *hash)
+{
+	size_t i, j, mask;
+	size_t size = hash->nh_size ? hash->nh_size * 2 : NLS_HASH_INIT_SIZE;
+	nls_hash_entry **table = calloc(size, sizeof(nls_hash_entry*));
+
+	if (!table) {
+		return ENOMEM;
+	}
+	mask = size - 1;
+	for (i = 0; i < hash->nh_size; i++) {
+		nls_hash_entry *ent = hash->nh_table[i];
+
+		if (!ent) {
+			continue;
+		}
+		for (j = ent->nhe_key->ns_hash & mask; table[j]; j = (j + 1) & mask) {
+			/* Probe for a free slot. */
+		}
+		table[j] = ent;
+	}
+	free(hash->nh_table);
+	hash->nh_table = table;
+	hash->nh_size = size;
+	return 0;
+}
+#ifdef NLS_UNIT_TEST
+int
+main()
+{
+	nls_init(stdout, stderr);
+
+	test_nls_hash_add();
+	test_nls_hash_add_replace();
+	test_nls_hash_add_many();
+	test_nls_hash_remove();
+
+        fprintf(stdout, "\n");
+	nls_term();
+	return 0;
+}
+#endif /* NLS_UNIT_TEST */
@@ -0,0 +1,939 @@
+/*
+ * Nameless - A lambda calculation language.
+ * Copyright (C) 2009 Yoshifumi Shimono <yoshifumi.shimono@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdlib.h>
+#include <errno.h>
+#include "nameless.h"
+#include "nameless/node.h"
+#include "nameless/mm.h"
+#include "nameless/function.h"
+
+#define NLS_MSG_UNBOUND_INDEX  "Unbound variable index"
+#define NLS_MSG_INVALID_OPCODE "Invalid opcode"
+
+#define NLS_VM_FRAME_ARGS      8 /* Most arguments of a compiled call */
+#define NLS_VM_CODE_INIT_SIZE  64
+#define NLS_VM_STACK_INIT_SIZE 256
+
+#if defined(__GNUC__) && !defined(NLS_VM_SWITCH)
+# define NLS_VM_THREADED /* Dispatch by computed goto */
+#endif
+
+/*
+ * Bytecode evaluator. Each top-level expression, and each global
+ * abstraction on its first call, is compiled into a flat array of words:
+ * an opcode followed by its operands. A term compiles to a sequence that
+ * pushes its value and returns. The sequences of the arguments of an
+ * application come before its own, so a call passes each argument as
+ * the offset of its code. Arguments stay call by name: a parameter is a
+ * thunk of the argument code and the frame of the caller, run at each
+ * use.
+ *
+ * What the compiler does not handle, such as partial application or
+ * a builtin like abst, falls back to nls_env_eval() on the instantiated
+ * term, so the results are those of the environment evaluator.
+ */
+
+/*
+ * Opcodes, each followed by its operands. An offset is relative to the
+ * word holding it.
+ */
+typedef enum {
+	NLS_OP_CONST,   /* node: push node */
+	NLS_OP_GLOBAL,  /* var: push its definition, or var if undefined */
+	NLS_OP_ARG,     /* var: push the value of a parameter */
+	NLS_OP_CLOSURE, /* term: push term closed over the frame */
+	NLS_OP_EVAL,    /* offset: push the value of a sequence */
+	NLS_OP_GUARD,   /* var func offset: jump unless var is func */
+	NLS_OP_ADD,     /* pop two ints, push the result */
+	NLS_OP_SUB,
+	NLS_OP_MUL,
+	NLS_OP_DIV,
+	NLS_OP_MOD,
+	NLS_OP_SET,     /* var term: define var, push the definition */
+	NLS_OP_CALL,    /* func n term (offset arg)*n: apply a global */
+	NLS_OP_ENTER,   /* offset n (offset arg)*n: apply a literal abstraction */
+	NLS_OP_APPLY,   /* term: evaluate by nls_env_eval() */
+	NLS_OP_JMP,     /* offset */
+	NLS_OP_RET,
+} nls_vm_opcode;
+
+#define NLS_VM_TARGET(word) ((word) + *(word))
+
+typedef struct _nls_vm_code {
+	intptr_t *nvc_words;
+	int nvc_num;
+	int nvc_size;
+	int nvc_failed; /* Out of memory while compiling */
+	int nvc_entry;  /* Offset of the sequence of the whole term */
+	nls_node *nvc_root; /* Holds the nodes referred to by the code */
+	struct _nls_vm_code *nvc_next;
+} nls_vm_code;
+
+struct _nls_vm_frame;
+
+/* A parameter: the code of an argument and the frame to run it in. */
+typedef struct _nls_vm_thunk {
+	const intptr_t *nvt_pc;
+	nls_node *nvt_term; /* The argument, for instantiation */
+	struct _nls_vm_frame *nvt_frame;
+} nls_vm_thunk;
+
+typedef struct _nls_vm_frame {
+	nls_vm_thunk *nvf_args;
+	int nvf_num_args;
+	struct _nls_vm_frame *nvf_up;
+} nls_vm_frame;
+
+/*
+ * Code of each global slot, compiled from the abstraction the slot held
+ * at the time. Code replaced while it may still run is retired, and
+ * freed at the end of the top-level expression.
+ */
+static nls_vm_code **nls_vm_defs;
+static int nls_vm_defs_size;
+static nls_vm_code *nls_vm_retired;
+
+/* Values and return addresses of the running sequences. */
+static nls_node **nls_vm_stack;
+static const intptr_t **nls_vm_rstack;
+static int nls_vm_sp;
+static int nls_vm_rsp;
+static int nls_vm_stack_size;
+
+static int nls_vm_run(const intptr_t *pc, nls_vm_frame *frame, nls_node **out);
+static int nls_vm_call(nls_node *func, const intptr_t *args, int n, nls_node *term, nls_vm_frame *frame, nls_node **out);
+static int nls_vm_enter(const intptr_t *pc, const intptr_t *args, int n, nls_vm_frame *frame, nls_vm_frame *up, nls_node **out);
+static int nls_vm_strict_call(nls_node *func, const intptr_t *args, int n, nls_vm_frame *frame, nls_node **out);
+static int nls_vm_force(nls_node *var, nls_vm_frame *frame, nls_node **out);
+static int nls_vm_operand(nls_node **value);
+static int nls_vm_fallback(nls_node *func, nls_node *args, nls_vm_frame *frame, nls_node **out);
+static nls_vm_thunk* nls_vm_lookup(nls_node *var, nls_vm_frame *frame, int depth);
+static nls_node* nls_vm_arg_of(nls_node *var, void *frame, int depth, void **arg_frame);
+static int nls_vm_stack_grow(void);
+static nls_vm_code* nls_vm_def_code(int slot, nls_node *abst);
+static void nls_vm_defs_clear(void);
+static nls_vm_code* nls_vm_compile(nls_node *root, nls_node *term);
+static void nls_vm_code_free(nls_vm_code *code);
+static int nls_vm_compile_seq(nls_vm_code *code, nls_node *term);
+static int nls_vm_compile_app(nls_vm_code *code, nls_node *term);
+static int nls_vm_compile_apply(nls_vm_code *code, nls_node *term);
+static void nls_vm_compile_leaf(nls_vm_code *code, nls_node *term);
+static void nls_vm_compile_operand(nls_vm_code *code, nls_node *term, int seq);
+static void nls_vm_compile_call(nls_vm_code *code, nls_node *func, nls_node *term, nls_node **args, int *seqs, int n);
+static int nls_vm_builtin_op(nls_node *func, int n);
+static void nls_vm_emit(nls_vm_code *code, intptr_t word);
+static void nls_vm_emit_offset(nls_vm_code *code, int target);
+static void nls_vm_patch(nls_vm_code *code, int pos);
+
+/**
+ * [DESTRUCTIVE] Evaluate an expression as nls_env_eval() does, by
+ * compiling it to bytecode first.
+ * @param  tree Target syntax tree.
+ * @retval 0    Evaluation succeed.
+ * @retval else Error code.
+ */
+int
+nls_vm_eval(nls_node **tree)
+{
+	int ret;
+	nls_node *out;
+	nls_vm_code *code, *next;
+
+	if (!(code = nls_vm_compile(*tree, *tree))) {
+		return ENOMEM;
+	}
+	ret = nls_vm_run(code->nvc_words + code->nvc_entry, NULL, &out);
+	nls_vm_code_free(code);
+	for (code = nls_vm_retired; code; code = next) {
+		next = code->nvc_next;
+		nls_vm_code_free(code);
+	}
+	nls_vm_retired = NULL;
+#ifdef NLS_GC
+	/* A collection moves the nodes the code refers to. */
+	nls_vm_defs_clear();
+#endif /* NLS_GC */
+	if (ret) {
+		return ret;
+	}
+	nls_release(*tree);
+	*tree = out;
+	return 0;
+}
+
+void
+nls_vm_term(void)
+{
+	nls_vm_defs_clear();
+	free(nls_vm_defs);
+	nls_vm_defs = NULL;
+	nls_vm_defs_size = 0;
+	free(nls_vm_stack);
+	free(nls_vm_rstack);
+	nls_vm_stack = NULL;
+	nls_vm_rstack = NULL;
+	nls_vm_stack_size = 0;
+}
+
+#ifdef NLS_VM_THREADED
+# define NLS_VM_CASE(op) nls_vm_##op
+# define NLS_VM_LABEL(op) [op] = &&nls_vm_##op
+# define NLS_VM_NEXT() goto *nls_vm_labels[*pc]
+#else
+# define NLS_VM_CASE(op) case op
+# define NLS_VM_NEXT() goto dispatch
+#endif /* NLS_VM_THREADED */
+
+#define NLS_VM_PUSH(node) \
+	do { \
+		if (nls_vm_sp == nls_vm_stack_size && nls_vm_stack_grow()) { \
+			nls_release(node); \
+			ret = ENOMEM; \
+			goto error_exit; \
+		} \
+		nls_vm_stack[nls_vm_sp++] = (node); \
+	} while (0)
+
+#define NLS_VM_ARITH(op) \
+	do { \
+		rhs = nls_vm_stack[--nls_vm_sp]; \
+		lhs = nls_vm_stack[--nls_vm_sp]; \
+		if ((!NLS_ISINT(lhs) && (ret = nls_vm_operand(&lhs))) || \
+			(!NLS_ISINT(rhs) && (ret = nls_vm_operand(&rhs)))) { \
+			nls_release(lhs); \
+			nls_release(rhs); \
+			goto error_exit; \
+		} \
+		a = NLS_INT_VAL(lhs); \
+		b = NLS_INT_VAL(rhs); \
+		nls_release(lhs); \
+		nls_release(rhs); \
+		if (!(value = nls_int_new(a op b))) { \
+			ret = ENOMEM; \
+			goto error_exit; \
+		} \
+		value = nls_grab(value); \
+		NLS_VM_PUSH(value); \
+		pc++; \
+	} while (0)
+
+/*
+ * Run the sequence at pc in frame. On success, *out holds a reference.
+ */
+static int
+nls_vm_run(const intptr_t *pc, nls_vm_frame *frame, nls_node **out)
+{
+#ifdef NLS_VM_THREADED
+	static void *nls_vm_labels[] = {
+		NLS_VM_LABEL(NLS_OP_CONST),
+		NLS_VM_LABEL(NLS_OP_GLOBAL),
+		NLS_VM_LABEL(NLS_OP_ARG),
+		NLS_VM_LABEL(NLS_OP_CLOSURE),
+		NLS_VM_LABEL(NLS_OP_EVAL),
+		NLS_VM_LABEL(NLS_OP_GUARD),
+		NLS_VM_LABEL(NLS_OP_ADD),
+		NLS_VM_LABEL(NLS_OP_SUB),
+		NLS_VM_LABEL(NLS_OP_MUL),
+		NLS_VM_LABEL(NLS_OP_DIV),
+		NLS_VM_LABEL(NLS_OP_MOD),
+		NLS_VM_LABEL(NLS_OP_SET),
+		NLS_VM_LABEL(NLS_OP_CALL),
+		NLS_VM_LABEL(NLS_OP_ENTER),
+		NLS_VM_LABEL(NLS_OP_APPLY),
+		NLS_VM_LABEL(NLS_OP_JMP),
+		NLS_VM_LABEL(NLS_OP_RET),
+	};
+#endif /* NLS_VM_THREADED */
+	int a, b, n, ret;
+	nls_node *value, *lhs, *rhs;
+	int base = nls_vm_sp, rbase = nls_vm_rsp;
+
+#ifdef NLS_VM_THREADED
+	NLS_VM_NEXT();
+#else
+dispatch:
+	switch (*pc) {
+	default:
+		NLS_BUG(NLS_MSG_INVALID_OPCODE ": %d", (int)*pc);
+		ret = EINVAL;
+		goto error_exit;
+#endif /* NLS_VM_THREADED */
+	NLS_VM_CASE(NLS_OP_CONST):
+		value = nls_grab((nls_node*)pc[1]);
+		NLS_VM_PUSH(value);
+		pc += 2;
+		NLS_VM_NEXT();
+	NLS_VM_CASE(NLS_OP_GLOBAL):
+		if (!(value = nls_symbol_get((nls_node*)pc[1]))) {
+			value = (nls_node*)pc[1];
+		}
+		value = nls_grab(value);
+		NLS_VM_PUSH(value);
+		pc += 2;
+		NLS_VM_NEXT();
+	NLS_VM_CASE(NLS_OP_ARG):
+		if ((ret = nls_vm_force((nls_node*)pc[1], frame, &value))) {
+			goto error_exit;
+		}
+		NLS_VM_PUSH(value);
+		pc += 2;
+		NLS_VM_NEXT();
+	NLS_VM_CASE(NLS_OP_CLOSURE):
+		if (!(value = nls_node_inst((nls_node*)pc[1], frame, 0, nls_vm_arg_of))) {
+			ret = ENOMEM;
+			goto error_exit;
+		}
+		NLS_VM_PUSH(value);
+		pc += 2;
+		NLS_VM_NEXT();
+	NLS_VM_CASE(NLS_OP_EVAL):
+		if (nls_vm_rsp == nls_vm_stack_size && nls_vm_stack_grow()) {
+			ret = ENOMEM;
+			goto error_exit;
+		}
+		nls_vm_rstack[nls_vm_rsp++] = pc + 2;
+		pc = NLS_VM_TARGET(&pc[1]);
+		NLS_VM_NEXT();
+	NLS_VM_CASE(NLS_OP_GUARD):
+		if (nls_symbol_get((nls_node*)pc[1]) != (nls_node*)pc[2]) {
+			pc = NLS_VM_TARGET(&pc[3]);
+			NLS_VM_NEXT();
+		}
+		pc += 4;
+		NLS_VM_NEXT();
+	NLS_VM_CASE(NLS_OP_ADD):
+		NLS_VM_ARITH(+);
+		NLS_VM_NEXT();
+	NLS_VM_CASE(NLS_OP_SUB):
+		NLS_VM_ARITH(-);
+		NLS_VM_NEXT();
+	NLS_VM_CASE(NLS_OP_MUL):
+		NLS_VM_ARITH(*);
+		NLS_VM_NEXT();
+	NLS_VM_CASE(NLS_OP_DIV):
+		NLS_VM_ARITH(/);
+		NLS_VM_NEXT();
+	NLS_VM_CASE(NLS_OP_MOD):
+		NLS_VM_ARITH(%);
+		NLS_VM_NEXT();
+	NLS_VM_CASE(NLS_OP_SET):
+		if (!(value = nls_node_inst((nls_node*)pc[2], frame, 0, nls_vm_arg_of))) {
+			ret = ENOMEM;
+			goto error_exit;
+		}
+		nls_symbol_set((nls_node*)pc[1], value);
+		NLS_VM_PUSH(value);
+		pc += 3;
+		NLS_VM_NEXT();
+	NLS_VM_CASE(NLS_OP_CALL):
+		n = pc[2];
+		if ((ret = nls_vm_call((nls_node*)pc[1], &pc[4], n,
+				(nls_node*)pc[3], frame, &value))) {
+			goto error_exit;
+		}
+		NLS_VM_PUSH(value);
+		pc += 4 + 2 * n;
+		NLS_VM_NEXT();
+	NLS_VM_CASE(NLS_OP_ENTER):
+		n = pc[2];
+		if ((ret = nls_vm_enter(NLS_VM_TARGET(&pc[1]), &pc[3], n,
+				frame, frame, &value))) {
+			goto error_exit;
+		}
+		NLS_VM_PUSH(value);
+		pc += 3 + 2 * n;
+		NLS_VM_NEXT();
+	NLS_VM_CASE(NLS_OP_APPLY):
+		value = (nls_node*)pc[1];
+		if ((ret = nls_vm_fallback(value->nn_app.nap_func,
+				value->nn_app.nap_args, frame, &value))) {
+			goto error_exit;
+		}
+		NLS_VM_PUSH(value);
+		pc += 2;
+		NLS_VM_NEXT();
+	NLS_VM_CASE(NLS_OP_JMP):
+		pc = NLS_VM_TARGET(&pc[1]);
+		NLS_VM_NEXT();
+	NLS_VM_CASE(NLS_OP_RET):
+		if (nls_vm_rsp > rbase) {
+			pc = nls_vm_rstack[--nls_vm_rsp];
+			NLS_VM_NEXT();
+		}
+		*out = nls_vm_stack[--nls_vm_sp];
+		return 0;
+#ifndef NLS_VM_THREADED
+	}
+#endif /* NLS_VM_THREADED */
+error_exit:
+	while (nls_vm_sp > base) {
+		nls_release(nls_vm_stack[--nls_vm_sp]);
+	}
+	nls_vm_rsp = rbase;
+	return ret;
+}
+
+/*
+ * Apply a global, or a builtin, to the arguments at args.
+ */
+static int
+nls_vm_call(nls_node *func, const intptr_t *args, int n, nls_node *term, nls_vm_frame *frame, nls_node **out)
+{
+	nls_vm_code *code;
+	nls_node *value = func;
+
+	if (NLS_ISVAR(func) && !(value = nls_symbol_get(func))) {
+		NLS_ERROR(NLS_MSG_NO_SUCH_SYMBOL ": %s",
+			func->nn_var.nv_name->ns_buf);
+		return EINVAL;
+	}
+	switch (NLS_NODE_TYPE(value)) {
+	case NLS_TYPE_FUNCTION:
+		if (value->nn_func.nf_strict && value->nn_func.nf_num_args == n) {
+			return nls_vm_strict_call(value, args, n, frame, out);
+		}
+		break;
+	case NLS_TYPE_ABSTRACTION:
+		if (value->nn_abst.nab_num_args != n) {
+			break;
+		}
+		/* Only a variable holds an abstraction in function position. */
+		if (!(code = nls_vm_def_code(func->nn_var.nv_slot, value))) {
+			return ENOMEM;
+		}
+		return nls_vm_enter(code->nvc_words + code->nvc_entry,
+			args, n, frame, NULL, out);
+	default:
+		break;
+	}
+	return nls_vm_fallback(value, term->nn_app.nap_args, frame, out);
+}
+
+/*
+ * Run the body at pc in a new frame binding the arguments at args, which
+ * run in frame. up is the frame of the parameters further out.
+ */
+static int
+nls_vm_enter(const intptr_t *pc, const intptr_t *args, int n, nls_vm_frame *frame, nls_vm_frame *up, nls_node **out)
+{
+	int i, ret;
+	nls_vm_frame callee;
+	nls_vm_thunk thunks[NLS_VM_FRAME_ARGS];
+
+	for (i = 0; i < n; i++) {
+		nls_node *arg = (nls_node*)args[2*i+1];
+
+		if (frame && NLS_ISVAR(arg) && 0 <= arg->nn_var.nv_index) {
+			/* Passed on as it is: share the thunk of the caller. */
+			thunks[i] = *nls_vm_lookup(arg, frame, 0);
+			continue;
+		}
+		thunks[i].nvt_pc = NLS_VM_TARGET(&args[2*i]);
+		thunks[i].nvt_term = arg;
+		thunks[i].nvt_frame = frame;
+	}
+	callee.nvf_args = thunks;
+	callee.nvf_num_args = n;
+	callee.nvf_up = up;
+	if ((ret = nls_eval_enter())) {
+		return ret;
+	}
+	ret = nls_vm_run(pc, &callee, out);
+	nls_eval_leave();
+	return ret;
+}
+
+/*
+ * Call a strict builtin with the values of the arguments at args, as
+ * the environment evaluator does.
+ */
+static int
+nls_vm_strict_call(nls_node *func, const intptr_t *args, int n, nls_vm_frame *frame, nls_node **out)
+{
+	int i, ret = 0;
+	nls_node *value;
+	nls_node cells[NLS_VM_FRAME_ARGS];
+
+	for (i = 0; i < n; i++) {
+		if ((ret = nls_vm_run(NLS_VM_TARGET(&args[2*i]), frame, &value))) {
+			break;
+		}
+		nls_list_init(&cells[i], value);
+		nls_release(value);
+		if (i) {
+			cells[i-1].nn_list.nl_rest = &cells[i];
+		}
+	}
+	if (!ret) {
+		*out = NULL;
+		if (!(ret = nls_function_call(func, cells, out))) {
+			*out = nls_grab(*out);
+			if (nls_sys_config.nc_intern) {
+				nls_node_intern(out);
+			}
+		}
+	}
+	while (i--) {
+		nls_release(cells[i].nn_list.nl_head);
+	}
+	return ret;
+}
+
+/*
+ * Value of a parameter: its argument run in the frame of the caller.
+ */
+static int
+nls_vm_force(nls_node *var, nls_vm_frame *frame, nls_node **out)
+{
+	nls_vm_thunk *thunk;
+
+	if (!frame) {
+		*out = nls_grab(var); /* Bound, but not applied yet. */
+		return 0;
+	}
+	thunk = nls_vm_lookup(var, frame, 0);
+	return nls_vm_run(thunk->nvt_pc, thunk->nvt_frame, out);
+}
+
+/*
+ * Reduce an operand of an arithmetic op that is not an int, as the
+ * builtin reduces its arguments: a global may hold an application.
+ */
+static int
+nls_vm_operand(nls_node **value)
+{
+	int ret;
+
+	if ((ret = nls_eval(value))) {
+		return ret;
+	}
+	return NLS_ISINT(*value) ? 0 : EINVAL;
+}
+
+/*
+ * Apply func to args instantiated in frame, by the environment
+ * evaluator.
+ */
+static int
+nls_vm_fallback(nls_node *func, nls_node *args, nls_vm_frame *frame, nls_node **out)
+{
+	int ret;
+	nls_node *actuals, *app;
+
+	if (!(actuals = nls_node_inst(args, frame, 0, nls_vm_arg_of))) {
+		return ENOMEM;
+	}
+	app = nls_application_new(func, actuals);
+	nls_release(actuals);
+	if (!app) {
+		return ENOMEM;
+	}
+	app = nls_grab(app);
+	if ((ret = nls_env_eval(&app))) {
+		nls_release(app);
+		return ret;
+	}
+	*out = app;
+	return 0;
+}
+
+/*
+ * Parameter a bound variable refers to, depth parameters inside frame.
+ */
+static nls_vm_thunk*
+nls_vm_lookup(nls_node *var, nls_vm_frame *frame, int depth)
+{
+	int i = var->nn_var.nv_index - depth;
+
+	for (; frame; frame = frame->nvf_up) {
+		if (i < frame->nvf_num_args) {
+			return &(frame->nvf_args[i]);
+		}
+		i -= frame->nvf_num_args;
+	}
+	NLS_BUG(NLS_MSG_UNBOUND_INDEX ": %d", var->nn_var.nv_index);
+	return NULL;
+}
+
+/*
+ * Argument a bound variable refers to, for nls_node_inst().
+ */
+static nls_node*
+nls_vm_arg_of(nls_node *var, void *frame, int depth, void **arg_frame)
+{
+	nls_vm_thunk *thunk = nls_vm_lookup(var, frame, depth);
+
+	if (!thunk) {
+		return NULL;
+	}
+	*arg_frame = thunk->nvt_frame;
+	return thunk->nvt_term;
+}
+
+/*
+ * Grow the value and return stacks together.
+ */
+static int
+nls_vm_stack_grow(void)
+{
+	nls_node **stack;
+	const intptr_t **rstack;
+	int size = nls_vm_stack_size ?
+		2 * nls_vm_stack_size : NLS_VM_STACK_INIT_SIZE;
+
+	if (!(stack = realloc(nls_vm_stack, size * sizeof(nls_node*)))) {
+		return ENOMEM;
+	}
+	nls_vm_stack = stack;
+	if (!(rstack = realloc(nls_vm_rstack, size * sizeof(intptr_t*)))) {
+		return ENOMEM;
+	}
+	nls_vm_rstack = rstack;
+	nls_vm_stack_size = size;
+	return 0;
+}
+
+/*
+ * Code of the abstraction a global slot holds, compiled on first use.
+ */
+static nls_vm_code*
+nls_vm_def_code(int slot, nls_node *abst)
+{
+	int i, size;
+	nls_vm_code **defs, *code;
+
+	if (slot >= nls_vm_defs_size) {
+		for (size = nls_vm_defs_size ? nls_vm_defs_size : 16;
+			size <= slot; size *= 2)
+			;
+		if (!(defs = realloc(nls_vm_defs, size * sizeof(nls_vm_code*)))) {
+			return NULL;
+		}
+		for (i = nls_vm_defs_size; i < size; i++) {
+			defs[i] = NULL;
+		}
+		nls_vm_defs = defs;
+		nls_vm_defs_size = size;
+	}
+	if ((code = nls_vm_defs[slot]) && code->nvc_root == abst) {
+		return code;
+	}
+	if (code) {
+		/* The slot was redefined, maybe by the running code itself. */
+		code->nvc_next = nls_vm_retired;
+		nls_vm_retired = code;
+	}
+	code = nls_vm_compile(abst, abst->nn_abst.nab_def);
+	nls_vm_defs[slot] = code;
+	return code;
+}
+
+static void
+nls_vm_defs_clear(void)
+{
+	int i;
+
+	for (i = 0; i < nls_vm_defs_size; i++) {
+		if (nls_vm_defs[i]) {
+			nls_vm_code_free(nls_vm_defs[i]);
+			nls_vm_defs[i] = NULL;
+		}
+	}
+}
+
+/*
+ * Compile term, a part of root. The code holds a reference to root.
+ */
+static nls_vm_code*
+nls_vm_compile(nls_node *root, nls_node *term)
+{
+	nls_vm_code *code;
+
+	if (!(code = malloc(sizeof(nls_vm_code)))) {
+		return NULL;
+	}
+	if (!(code->nvc_words = malloc(NLS_VM_CODE_INIT_SIZE * sizeof(intptr_t)))) {
+		free(code);
+		return NULL;
+	}
+	code->nvc_num = 0;
+	code->nvc_size = NLS_VM_CODE_INIT_SIZE;
+	code->nvc_failed = 0;
+	code->nvc_root = nls_grab(root);
+	code->nvc_next = NULL;
+	code->nvc_entry = nls_vm_compile_seq(code, term);
+	if (code->nvc_failed) {
+		nls_vm_code_free(code);
+		return NULL;
+	}
+	return code;
+}
+
+static void
+nls_vm_code_free(nls_vm_code *code)
+{
+	nls_release(code->nvc_root);
+	free(code->nvc_words);
+	free(code);
+}
+
+/*
+ * Compile term into a sequence that pushes its value. Returns the offset
+ * of the sequence.
+ */
+static int
+nls_vm_compile_seq(nls_vm_code *code, nls_node *term)
+{
+	int start;
+
+	if (NLS_ISAPP(term)) {
+		return nls_vm_compile_app(code, term);
+	}
+	start = code->nvc_num;
+	nls_vm_compile_leaf(code, term);
+	nls_vm_emit(code, NLS_OP_RET);
+	return start;
+}
+
+static int
+nls_vm_compile_app(nls_vm_code *code, nls_node *term)
+{
+	int i, n, op, start, body, guard = -1, end;
+	int seqs[NLS_VM_FRAME_ARGS];
+	nls_node *args[NLS_VM_FRAME_ARGS];
+	nls_node **item, *tmp, *value;
+	nls_node *func = term->nn_app.nap_func;
+
+	if (NLS_VM_FRAME_ARGS < (n = nls_list_count(term->nn_app.nap_args))) {
+		return nls_vm_compile_apply(code, term);
+	}
+	i = 0;
+	nls_list_foreach(term->nn_app.nap_args, &item, &tmp) {
+		args[i] = *item;
+		seqs[i] = nls_vm_compile_seq(code, *item);
+		i++;
+	}
+	switch (NLS_NODE_TYPE(func)) {
+	case NLS_TYPE_VAR:
+		nls_symbol_resolve(func);
+		value = nls_symbol_get(func);
+		break;
+	case NLS_TYPE_FUNCTION:
+		value = func;
+		break;
+	case NLS_TYPE_ABSTRACTION:
+		if (func->nn_abst.nab_num_args != n) {
+			return nls_vm_compile_apply(code, term);
+		}
+		body = nls_vm_compile_seq(code, func->nn_abst.nab_def);
+		start = code->nvc_num;
+		nls_vm_emit(code, NLS_OP_ENTER);
+		nls_vm_emit_offset(code, body);
+		nls_vm_emit(code, n);
+		for (i = 0; i < n; i++) {
+			nls_vm_emit_offset(code, seqs[i]);
+			nls_vm_emit(code, (intptr_t)args[i]);
+		}
+		nls_vm_emit(code, NLS_OP_RET);
+		return start;
+	default:
+		return nls_vm_compile_apply(code, term);
+	}
+	start = code->nvc_num;
+	op = nls_vm_builtin_op(value, n);
+	if (NLS_OP_SET == op && (!NLS_ISVAR(args[0]) || 0 <= args[0]->nn_var.nv_index)) {
+		op = -1;
+	}
+	if (0 > op) {
+		nls_vm_compile_call(code, func, term, args, seqs, n);
+		nls_vm_emit(code, NLS_OP_RET);
+		return start;
+	}
+	/* Inline the builtin, as long as the global still holds it. */
+	if (NLS_ISVAR(func)) {
+		nls_vm_emit(code, NLS_OP_GUARD);
+		nls_vm_emit(code, (intptr_t)func);
+		nls_vm_emit(code, (intptr_t)value);
+		guard = code->nvc_num;
+		nls_vm_emit(code, 0);
+	}
+	if (NLS_OP_SET == op) {
+		nls_symbol_resolve(args[0]);
+		nls_vm_emit(code, NLS_OP_SET);
+		nls_vm_emit(code, (intptr_t)args[0]);
+		nls_vm_emit(code, (intptr_t)args[1]);
+	} else {
+		nls_vm_compile_operand(code, args[0], seqs[0]);
+		nls_vm_compile_operand(code, args[1], seqs[1]);
+		nls_vm_emit(code, op);
+	}
+	if (0 <= guard) {
+		nls_vm_emit(code, NLS_OP_JMP);
+		end = code->nvc_num;
+		nls_vm_emit(code, 0);
+		nls_vm_patch(code, guard);
+		nls_vm_compile_call(code, func, term, args, seqs, n);
+		nls_vm_patch(code, end);
+	}
+	nls_vm_emit(code, NLS_OP_RET);
+	return start;
+}
+
+static int
+nls_vm_compile_apply(nls_vm_code *code, nls_node *term)
+{
+	int start = code->nvc_num;
+
+	nls_vm_emit(code, NLS_OP_APPLY);
+	nls_vm_emit(code, (intptr_t)term);
+	nls_vm_emit(code, NLS_OP_RET);
+	return start;
+}
+
+/*
+ * Code pushing the value of a term other than an application.
+ */
+static void
+nls_vm_compile_leaf(nls_vm_code *code, nls_node *term)
+{
+	switch (NLS_NODE_TYPE(term)) {
+	case NLS_TYPE_VAR:
+		if (0 <= term->nn_var.nv_index) {
+			nls_vm_emit(code, NLS_OP_ARG);
+			nls_vm_emit(code, (intptr_t)term);
+			return;
+		}
+		nls_symbol_resolve(term);
+		nls_vm_emit(code, NLS_OP_GLOBAL);
+		nls_vm_emit(code, (intptr_t)term);
+		return;
+	case NLS_TYPE_ABSTRACTION:
+	case NLS_TYPE_LIST:
+		if (!nls_node_closed(term, 0)) {
+			nls_vm_emit(code, NLS_OP_CLOSURE);
+			nls_vm_emit(code, (intptr_t)term);
+			return;
+		}
+		break;
+	default:
+		break;
+	}
+	nls_vm_emit(code, NLS_OP_CONST);
+	nls_vm_emit(code, (intptr_t)term);
+}
+
+/*
+ * Code pushing the value of an argument compiled at seq: a leaf is
+ * repeated in place, anything else is called.
+ */
+static void
+nls_vm_compile_operand(nls_vm_code *code, nls_node *term, int seq)
+{
+	if (!NLS_ISAPP(term)) {
+		nls_vm_compile_leaf(code, term);
+		return;
+	}
+	nls_vm_emit(code, NLS_OP_EVAL);
+	nls_vm_emit_offset(code, seq);
+}
+
+static void
+nls_vm_compile_call(nls_vm_code *code, nls_node *func, nls_node *term, nls_node **args, int *seqs, int n)
+{
+	int i;
+
+	nls_vm_emit(code, NLS_OP_CALL);
+	nls_vm_emit(code, (intptr_t)func);
+	nls_vm_emit(code, n);
+	nls_vm_emit(code, (intptr_t)term);
+	for (i = 0; i < n; i++) {
+		nls_vm_emit_offset(code, seqs[i]);
+		nls_vm_emit(code, (intptr_t)args[i]);
+	}
+}
+
+/*
+ * Opcode standing for a call of func with n arguments, or -1.
+ */
+static int
+nls_vm_builtin_op(nls_node *func, int n)
+{
+	nls_fp fp;
+
+	if (!func || NLS_TYPE_FUNCTION != NLS_NODE_TYPE(func) || 2 != n) {
+		return -1;
+	}
+	fp = func->nn_func.nf_fp;
+	if (nls_func_add == fp) {
+		return NLS_OP_ADD;
+	}
+	if (nls_func_sub == fp) {
+		return NLS_OP_SUB;
+	}
+	if (nls_func_mul == fp) {
+		return NLS_OP_MUL;
+	}
+	if (nls_func_div == fp) {
+		return NLS_OP_DIV;
+	}
+	if (nls_func_mod == fp) {
+		return NLS_OP_MOD;
+	}
+	if (nls_func_set == fp) {
+		return NLS_OP_SET;
+	}
+	return -1;
+}
+
+static void
+nls_vm_emit(nls_vm_code *code, intptr_t word)
+{
+	intptr_t *words;
+
+	if (code->nvc_failed) {
+		return;
+	}
+	if (code->nvc_num == code->nvc_size) {
+		words = realloc(code->nvc_words,
+			2 * code->nvc_size * sizeof(intptr_t));
+		if (!words) {
+			code->nvc_failed = 1;
+			return;
+		}
+		code->nvc_words = words;
+		code->nvc_size *= 2;
+	}
+	code->nvc_words[code->nvc_num++] = word;
+}
+
+static void
+nls_vm_emit_offset(nls_vm_code *code, int target)
+{
+	nls_vm_emit(code, target - code->nvc_num);
+}
+
+/*
+ * Point the offset at pos to the end of the code.
+ */
+static void
+nls_vm_patch(nls_vm_code *code, int pos)
+{
+	if (!code->nvc_failed) {
+		code->nvc_words[pos] = code->nvc_num - pos;
+	}
+}